@@ -0,0 +1,12 @@
+//react-native-fetch-blob reads its native module when it is imported. Tests that send requests
+//through it mock it with a transport of their own (__tests__/benchmarks/syncLoad).
+const fetch = jest.fn(() => Promise.reject(new Error('no network in tests')));
+
+module.exports = {
+    fetch: fetch,
+    config: () => ({fetch: fetch}),
+    fs: {
+        unlink: () => Promise.resolve(),
+        readStream: () => Promise.reject(new Error('no files in tests'))
+    }
+};
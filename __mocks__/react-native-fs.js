@@ -0,0 +1,26 @@
+//In-memory file system for the sync journal and checkpoint, the files are in __files
+const files = {};
+
+module.exports = {
+    DocumentDirectoryPath: '/documents',
+    __files: files,
+    exists: (path) => Promise.resolve(files.hasOwnProperty(path)),
+    readFile: (path) => Promise.resolve(files[path]),
+    writeFile: (path, text) => {
+        files[path] = text;
+        return Promise.resolve();
+    },
+    appendFile: (path, text) => {
+        files[path] = (files[path] || "") + text;
+        return Promise.resolve();
+    },
+    unlink: (path) => {
+        delete files[path];
+        return Promise.resolve();
+    },
+    moveFile: (from, to) => {
+        files[to] = files[from];
+        delete files[from];
+        return Promise.resolve();
+    }
+};
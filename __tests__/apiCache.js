@@ -0,0 +1,63 @@
+import { AsyncStorage } from 'react-native';
+import {
+    readCache,
+    writeCache,
+    getCacheGeneration,
+    invalidateCache
+} from '../src/services/apiCache';
+
+const API = 'http://api.example.com/api/v1/';
+const MEDIA = 'http://media.example.com/api/v1/';
+
+const isCached = (url) => readCache(url).then((entry) => entry !== undefined);
+
+const areCached = (urls) => Promise.all(urls.map(isCached));
+
+describe('apiCache', () => {
+
+    it('drops the written resource, its list and related reads only', () => {
+        let urls = [
+            API + 'agent',
+            API + 'agent/search?query=a',
+            API + 'report',
+            API + 'report/5',
+            API + 'report/5/property',
+            MEDIA + 'reportsubsection/3/images/report/5',
+            API + 'report/6/property',
+            API + 'reporttemplate'
+        ];
+        urls.forEach((url) => writeCache(url, {url: url}, undefined));
+
+        return invalidateCache(API + 'agent', [])
+            .then(() => areCached(urls))
+            .then((cached) => {
+                expect(cached).toEqual([false, false, true, true, true, true, true, true]);
+                return invalidateCache(API + 'report/5/property', ['report/5']);
+            })
+            .then(() => areCached(urls.slice(2)))
+            .then((cached) => {
+                expect(cached).toEqual([true, false, false, false, true, true]);
+                expect(AsyncStorage.__items['apiCache:' + API + 'report/6/property']).toBeDefined();
+                expect(AsyncStorage.__items['apiCache:' + API + 'report/5']).toBeUndefined();
+            });
+    });
+
+    it('reads the stored keys once', () => {
+        let getAllKeys = jest.spyOn(AsyncStorage, 'getAllKeys');
+        return invalidateCache(API + 'client', [])
+            .then(() => invalidateCache(API + 'reportfiledata', ['report/7']))
+            .then(() => {
+                expect(getAllKeys).not.toHaveBeenCalled();
+                getAllKeys.mockRestore();
+            });
+    });
+
+    it('does not keep a response fetched before a write that dropped it', () => {
+        let before = getCacheGeneration();
+        return invalidateCache(API + 'report/8', []).then(() => {
+            expect(writeCache(API + 'report/8', {}, undefined, before)).toBeUndefined();
+            expect(writeCache(API + 'report/9', {}, undefined, before)).toBeDefined();
+            expect(writeCache(API + 'report/8', {}, undefined, getCacheGeneration())).toBeDefined();
+        });
+    });
+});
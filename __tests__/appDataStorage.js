@@ -0,0 +1,98 @@
+jest.mock('react-native', () => ({
+    Dimensions: {get: () => ({width: 375, height: 667})},
+    Platform: {OS: 'ios'},
+    AppState: {addEventListener: () => {}},
+    InteractionManager: {runAfterInteractions: (callback) => callback()},
+    AsyncStorage: require.requireActual('react-native').AsyncStorage
+}));
+
+import { AsyncStorage } from 'react-native';
+import { encode } from '../src/services/compactJson';
+import {
+    loadAppData,
+    loadReportBody,
+    startAppDataStorage,
+    flushAppData
+} from '../src/services/appDataStorage';
+
+const BODY = {
+    id: 1,
+    report_id: 1,
+    template_id: 1,
+    name: 'Report 1',
+    property: {id: 5, address: 'Street', city: 'City', image_path: 'old.jpg'},
+    data: {subsection_1: {filedata: {id: 11, form_data: {note: 'text'}}, images: [], videos: []}}
+};
+
+const createStore = (appAllData) => {
+    let listeners = [];
+    let store = {
+        appAllData: appAllData,
+        getState: () => ({appAllData: store.appAllData}),
+        subscribe: (listener) => {
+            listeners.push(listener);
+            return () => {
+                listeners = listeners.filter((item) => item !== listener);
+            };
+        },
+        setReport: (update) => {
+            let reports = store.appAllData.reports.slice();
+            reports[0] = update(reports[0]);
+            store.appAllData = Object.assign({}, store.appAllData, {reports: reports});
+            listeners.forEach((listener) => listener());
+        }
+    };
+    return store;
+};
+
+describe('appDataStorage', () => {
+
+    let store = null;
+
+    beforeAll(() => {
+        AsyncStorage.__items['appData:report:1'] = encode(BODY);
+        AsyncStorage.__items['appData:index'] = encode({
+            reports: [{id: 1, report_id: 1, template_id: 1, name: 'Report 1', property: {address: 'Street', city: 'City'}, isSummary: true}],
+            templates: [],
+            comments: [],
+            dataLoaded: true,
+            summaries: true
+        });
+
+        return loadAppData().then((appAllData) => {
+            store = createStore(appAllData);
+            startAppDataStorage(store);
+        });
+    });
+
+    it('writes the changes of a report that was never opened into its body', () => {
+        store.setReport((report) => Object.assign({}, report, {name: 'Renamed'}));
+        store.setReport((report) => Object.assign({}, report, {
+            property: Object.assign({}, report.property, {image_path: 'server.jpg'})
+        }));
+
+        return flushAppData()
+            .then(() => loadReportBody(1))
+            .then((body) => {
+                expect(body.name).toBe('Renamed');
+                expect(body.property).toEqual(Object.assign({}, BODY.property, {image_path: 'server.jpg'}));
+                expect(body.data).toEqual(BODY.data);
+                expect(body.isSummary).toBeUndefined();
+                return loadAppData();
+            })
+            .then((appAllData) => {
+                expect(appAllData.reports[0].name).toBe('Renamed');
+                expect(appAllData.reports[0].isSummary).toBe(true);
+            });
+    });
+
+    it('applies changes not written yet to a body read before the write', () => {
+        store.setReport((report) => Object.assign({}, report, {inspection_date_time: '2018-01-02'}));
+
+        return loadReportBody(1).then((body) => {
+            expect(body.inspection_date_time).toBe('2018-01-02');
+            expect(body.name).toBe('Renamed');
+            expect(body.data).toEqual(BODY.data);
+        });
+    });
+});
@@ -0,0 +1,125 @@
+jest.mock('axios', () => ({
+    post: jest.fn()
+}));
+
+import axios from 'axios';
+import { AsyncStorage } from 'react-native';
+import {
+    getSession,
+    setSession,
+    clearSession,
+    getAuthHeader,
+    refreshSession,
+    setRefreshListener
+} from '../src/services/authSession';
+
+const USER = {token: 'old', email: 'inspector@example.com', password: 'secret', username: 'inspector'};
+
+const signedIn = (token) => {
+    return {data: {token: token, user: {username: 'inspector', organization_id: 7, image_path: 'me.jpg'}}};
+};
+
+//A sign in the test answers when it likes
+const deferSignIn = () => {
+    let answer = {};
+    axios.post.mockImplementation(() => new Promise((resolve, reject) => {
+        answer.resolve = resolve;
+        answer.reject = reject;
+    }));
+    return answer;
+};
+
+const wait = () => new Promise((resolve) => setTimeout(resolve, 0));
+
+describe('authSession', () => {
+
+    beforeEach(() => {
+        axios.post.mockReset();
+        setRefreshListener(null);
+        return setSession(USER);
+    });
+
+    it('serves the user from memory', () => {
+        let getItem = jest.spyOn(AsyncStorage, 'getItem');
+        return Promise.all([getSession(), getAuthHeader()])
+            .then(([user, header]) => {
+                expect(user).toEqual(USER);
+                expect(header).toEqual({"Authorization": "Bearer old"});
+                return clearSession();
+            })
+            .then(() => getAuthHeader())
+            .then((header) => {
+                expect(header).toEqual({"Authorization": "Bearer "});
+                expect(getItem).not.toHaveBeenCalled();
+                getItem.mockRestore();
+            });
+    });
+
+    it('shares one sign in between concurrent requests answered with 401', () => {
+        let answer = deferSignIn();
+        let listener = jest.fn();
+        setRefreshListener(listener);
+
+        let refreshes = [refreshSession('old'), refreshSession('old'), refreshSession('old')];
+        return wait()
+            .then(() => {
+                expect(axios.post).toHaveBeenCalledTimes(1);
+                expect(axios.post.mock.calls[0][1]).toEqual({"email": USER.email, "password": USER.password, "isMobile": true});
+                answer.resolve(signedIn('new'));
+                return Promise.all(refreshes);
+            })
+            .then((users) => {
+                users.forEach((user) => expect(user.token).toBe('new'));
+                expect(listener).toHaveBeenCalledTimes(1);
+                return Promise.all([getAuthHeader(), AsyncStorage.getItem('user')]);
+            })
+            .then(([header, stored]) => {
+                expect(header).toEqual({"Authorization": "Bearer new"});
+                expect(JSON.parse(stored)).toEqual(Object.assign({}, USER, {token: 'new', organization_id: 7, profileimage: 'me.jpg'}));
+            });
+    });
+
+    it('does not sign in again for a token that was already replaced', () => {
+        let answer = deferSignIn();
+        let first = refreshSession('old');
+        return wait()
+            .then(() => {
+                answer.resolve(signedIn('new'));
+                return first;
+            })
+            .then(() => refreshSession('old'))
+            .then((user) => {
+                expect(user.token).toBe('new');
+                expect(axios.post).toHaveBeenCalledTimes(1);
+            });
+    });
+
+    it('lets the next request sign in again after a failed sign in', () => {
+        let answer = deferSignIn();
+        let refreshes = [refreshSession('old'), refreshSession('old')];
+        return wait()
+            .then(() => {
+                answer.reject(new Error('offline'));
+                return Promise.all(refreshes.map((refresh) => refresh.then(() => 'signed in', (error) => error.message)));
+            })
+            .then((results) => {
+                expect(results).toEqual(['offline', 'offline']);
+                axios.post.mockImplementation(() => Promise.resolve(signedIn('new')));
+                return refreshSession('old');
+            })
+            .then((user) => {
+                expect(user.token).toBe('new');
+                expect(axios.post).toHaveBeenCalledTimes(2);
+            });
+    });
+
+    it('rejects without credentials', () => {
+        return setSession({token: 'old'})
+            .then(() => refreshSession('old'))
+            .then(() => 'signed in', (error) => error.message)
+            .then((result) => {
+                expect(result).toBe('not signed in');
+                expect(axios.post).not.toHaveBeenCalled();
+            });
+    });
+});
@@ -0,0 +1,108 @@
+import {
+    createStore,
+    applyMiddleware,
+    compose
+} from 'redux';
+import thunk from 'redux-thunk';
+import {
+    batch,
+    batchedSubscribe
+} from '../src/services/batch';
+
+const createCounterStore = () => {
+    return createStore((state = 0, action) => (action.type === 'ADD') ? state + 1 : state,
+        compose(applyMiddleware(thunk), batchedSubscribe));
+};
+
+const add = () => ({type: 'ADD'});
+
+describe('batch', () => {
+
+    it('notifies every dispatch outside a batch', () => {
+        let store = createCounterStore();
+        let listener = jest.fn();
+        store.subscribe(listener);
+
+        store.dispatch(add());
+        store.dispatch(add());
+        expect(listener).toHaveBeenCalledTimes(2);
+    });
+
+    it('notifies once when the outermost batch ends', () => {
+        let store = createCounterStore();
+        let states = [];
+        store.subscribe(() => states.push(store.getState()));
+
+        let result = store.dispatch(batch((dispatch) => {
+            dispatch(add());
+            dispatch(batch((dispatch) => {
+                dispatch(add());
+                dispatch(add());
+            }));
+            expect(states).toEqual([]);
+            return 'done';
+        }));
+        expect(result).toBe('done');
+        expect(states).toEqual([3]);
+    });
+
+    it('does not notify a batch that dispatched nothing', () => {
+        let store = createCounterStore();
+        let listener = jest.fn();
+        store.subscribe(listener);
+
+        store.dispatch(batch(() => {}));
+        expect(listener).not.toHaveBeenCalled();
+    });
+
+    it('ends the batch when the thunk throws', () => {
+        let store = createCounterStore();
+        let listener = jest.fn();
+        store.subscribe(listener);
+
+        expect(() => store.dispatch(batch((dispatch) => {
+            dispatch(add());
+            throw new Error('failed');
+        }))).toThrow('failed');
+        expect(listener).toHaveBeenCalledTimes(1);
+
+        store.dispatch(add());
+        expect(listener).toHaveBeenCalledTimes(2);
+    });
+
+    it('notifies each store dispatched to and skips listeners removed meanwhile', () => {
+        let first = createCounterStore();
+        let second = createCounterStore();
+        let removed = jest.fn();
+        let kept = jest.fn();
+        let other = jest.fn();
+        let unsubscribe = first.subscribe(removed);
+        first.subscribe(kept);
+        second.subscribe(other);
+
+        first.dispatch(batch((dispatch) => {
+            dispatch(add());
+            second.dispatch(add());
+            unsubscribe();
+            unsubscribe();
+        }));
+        expect(removed).not.toHaveBeenCalled();
+        expect(kept).toHaveBeenCalledTimes(1);
+        expect(other).toHaveBeenCalledTimes(1);
+    });
+
+    it('leaves dispatches after an await unbatched', () => {
+        let store = createCounterStore();
+        let listener = jest.fn();
+        store.subscribe(listener);
+
+        return store.dispatch(batch((dispatch) => {
+            return Promise.resolve().then(() => {
+                dispatch(add());
+                dispatch(add());
+            });
+        })).then(() => {
+            expect(listener).toHaveBeenCalledTimes(2);
+        });
+    });
+});
@@ -0,0 +1,67 @@
+import data from '../../src/services/data.json';
+import {
+    encode,
+    decode
+} from '../../src/services/compactJson';
+
+//Read time of app data shards, on the data.json fixture as one document and on its reports as
+//one shard each, the way services/appDataStorage stores them:
+//  plain       JSON.parse of the plain text
+//  stored      decode of what appDataStorage writes now, plain JSON
+//  compact     decode of the compact encoding, with its size
+//Shards are read on startup and when a report opens, reading them must not get slower than
+//JSON.parse.
+
+const ITERATIONS = 50;
+const NOISE = 1.25;
+
+const byteLength = (text) => Buffer.byteLength(text, 'utf8');
+
+const time = (run) => {
+    run();
+    let start = process.hrtime();
+    for (let i = 0; i < ITERATIONS; i++) {
+        run();
+    }
+    let [seconds, nanoseconds] = process.hrtime(start);
+    return (seconds * 1e3 + nanoseconds / 1e6) / ITERATIONS;
+};
+
+const sum = (list, get) => list.reduce((total, item) => total + get(item), 0);
+
+const measure = (name, values) => {
+    let plain = values.map((value) => JSON.stringify(value));
+    let compact = values.map(encode);
+
+    let result = {
+        plainBytes: sum(plain, byteLength),
+        compactBytes: sum(compact, byteLength),
+        parseMs: time(() => plain.forEach((text) => JSON.parse(text))),
+        storedMs: time(() => plain.forEach((text) => decode(text))),
+        compactMs: time(() => compact.forEach((text) => decode(text)))
+    };
+    console.log(name + ': read ' + result.parseMs.toFixed(2) + ' ms plain / ' +
+        result.storedMs.toFixed(2) + ' ms stored (' + result.plainBytes + ' bytes) / ' +
+        result.compactMs.toFixed(2) + ' ms compact (' + result.compactBytes + ' bytes, ' +
+        (result.plainBytes / result.compactBytes).toFixed(2) + 'x smaller)');
+
+    plain.forEach((text, index) => {
+        expect(decode(text)).toEqual(values[index]);
+        expect(decode(compact[index])).toEqual(values[index]);
+    });
+    return result;
+};
+
+describe('app data shard reads', () => {
+
+    it('keep up with JSON.parse on the data.json fixture', () => {
+        let result = measure('data.json', [data]);
+        expect(result.storedMs).toBeLessThan(result.parseMs * NOISE);
+    });
+
+    it('keep up with JSON.parse on report shards', () => {
+        let reports = data.reports.data;
+        let result = measure(reports.length + ' report shards', reports);
+        expect(result.storedMs).toBeLessThan(result.parseMs * NOISE);
+    });
+});
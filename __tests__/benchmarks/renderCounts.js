@@ -0,0 +1,193 @@
+import {
+    createStore,
+    applyMiddleware,
+    compose,
+    combineReducers
+} from 'redux';
+import thunk from 'redux-thunk';
+import EntitiesReducer from '../../src/reducers/entitiesReducer';
+import ReportReducer from '../../src/reducers/reportReducer';
+import {
+    SET_ALL_REPORTS,
+    SET_ALL_COMMENTS,
+    SET_ALL_TEMPLATES
+} from '../../src/actions/type';
+import { batchedSubscribe } from '../../src/services/batch';
+import { shallowEqual } from '../../src/services/selector';
+import {
+    selectReportRows,
+    makeSelectSubsectionData,
+    makeSelectSubsectionComments,
+    getSelectedTemplate
+} from '../../src/selectors/appDataSelectors';
+import { setSelectedReport } from '../../src/actions/reportAction';
+import { updateReportFields } from '../../src/actions/entityAction';
+import { updateReportData } from '../../src/actions/reportFormDataAction';
+import { addComment } from '../../src/actions/commentAction';
+
+//Render counts of the report list and the inspection form over a scripted editing session,
+//with the props the screens selected before the memoized selectors and with the ones they
+//select now. A connected screen renders when its props are not shallow equal to the last ones.
+
+const REPORTS = 200;
+const SUBSECTIONS = 20;
+const EDITS = 50;
+const OPEN_SUBSECTION = 3;
+
+//appAllData as the screens see it, its reducer is not part of this tree
+const appAllData = (state = {reports: [], comments: {}, templates: []}, action) => {
+    switch (action.type) {
+        case SET_ALL_REPORTS:
+            return {...state, reports: action.payload};
+        case SET_ALL_COMMENTS:
+            return {...state, comments: action.payload};
+        case SET_ALL_TEMPLATES:
+            return {...state, templates: action.payload};
+        default:
+            return state;
+    }
+};
+
+const createReport = (report_id) => {
+    let data = {};
+    for (let i = 1; i <= SUBSECTIONS; i++) {
+        data['subsection_' + i] = {
+            filedata: {id: report_id * 100 + i, report_subsection_id: i, form_data: {note: 'text ' + i}},
+            images: [{id: report_id * 1000 + i, original: 'image.jpg'}],
+            videos: []
+        };
+    }
+    return {
+        id: report_id,
+        report_id: report_id,
+        template_id: 1,
+        name: 'Report ' + report_id,
+        property: {id: report_id, address: 'Street ' + report_id},
+        data: data
+    };
+};
+
+const createComments = () => {
+    let comments = {};
+    for (let i = 1; i <= SUBSECTIONS; i++) {
+        comments['subsection_' + i] = [{id: i, comment: 'comment ' + i}];
+    }
+    return comments;
+};
+
+const SCREENS = {
+    'report list': {
+        before: () => (state) => ({
+            reports: state.appAllData.reports
+        }),
+        after: () => (state) => ({
+            reports: selectReportRows(state)
+        })
+    },
+    'inspection form': {
+        before: () => (state) => ({
+            comments: state.appAllData.comments,
+            selectedReport: state.report.selectedReport
+        }),
+        after: () => {
+            const selectSubsectionComments = makeSelectSubsectionComments();
+            const selectSubsectionData = makeSelectSubsectionData();
+            return (state) => ({
+                comments: selectSubsectionComments(state, OPEN_SUBSECTION),
+                subsectionData: selectSubsectionData(state, OPEN_SUBSECTION),
+                selectedReport: state.report.selectedReport,
+                template: getSelectedTemplate(state)
+            });
+        }
+    }
+};
+
+const connectCounter = (store, mapStateToProps) => {
+    let counter = {renders: 0, ms: 0};
+    let props = mapStateToProps(store.getState());
+    store.subscribe(() => {
+        let start = Date.now();
+        let next = mapStateToProps(store.getState());
+        counter.ms += Date.now() - start;
+        if (!shallowEqual(next, props)) {
+            counter.renders++;
+        }
+        props = next;
+    });
+    return counter;
+};
+
+const createAppStore = () => {
+    let store = createStore(combineReducers({
+        appAllData: appAllData,
+        report: ReportReducer,
+        entities: EntitiesReducer
+    }), compose(applyMiddleware(thunk), batchedSubscribe));
+
+    let reports = [];
+    for (let i = 1; i <= REPORTS; i++) {
+        reports.push(createReport(i));
+    }
+    store.dispatch({type: SET_ALL_TEMPLATES, payload: [{template_id: 1, name: 'Template', sections: []}]});
+    store.dispatch({type: SET_ALL_REPORTS, payload: reports});
+    store.dispatch({type: SET_ALL_COMMENTS, payload: createComments()});
+    return store;
+};
+
+const runSession = (variant) => {
+    let store = createAppStore();
+
+    return store.dispatch(setSelectedReport(1, 1)).then(() => {
+        let counters = {};
+        Object.keys(SCREENS).forEach((name) => {
+            counters[name] = connectCounter(store, SCREENS[name][variant]());
+        });
+
+        for (let i = 0; i < EDITS; i++) {
+            //the form on screen saves its own subsection
+            let key = 'subsection_' + OPEN_SUBSECTION;
+            let subsection = Object.assign({}, store.getState().appAllData.reports[0].data[key]);
+            subsection.filedata = Object.assign({}, subsection.filedata, {form_data: {note: 'edit ' + i}});
+            store.dispatch(updateReportData({[key]: subsection}, 1));
+
+            //another subsection gets a comment
+            let other = 1 + (i % (SUBSECTIONS - 1));
+            store.dispatch(addComment({id: 1000 + i, comment: 'new'}, (other >= OPEN_SUBSECTION) ? other + 1 : other));
+
+            //a field the list does not show changes in another report
+            store.dispatch(updateReportFields(2 + (i % (REPORTS - 1)), {inspection_date_time: 'date ' + i}));
+        }
+        //a renamed report changes one row
+        store.dispatch(updateReportFields(2, {name: 'Renamed'}));
+        return counters;
+    });
+};
+
+describe('render counts', () => {
+
+    it('share the open report with the report list', () => {
+        let store = createAppStore();
+        let report = store.getState().appAllData.reports[0];
+
+        return store.dispatch(setSelectedReport(1, 1)).then(() => {
+            expect(store.getState().report.selectedReport.report).toBe(report);
+            expect(store.getState().appAllData.reports[0]).toBe(report);
+        });
+    });
+
+    it('are lower with memoized selectors', () => {
+        return Promise.all([runSession('before'), runSession('after')]).then(([before, after]) => {
+            Object.keys(SCREENS).forEach((name) => {
+                console.log(name + ': ' + before[name].renders + ' renders (' + before[name].ms + ' ms in mapStateToProps) before, ' +
+                    after[name].renders + ' renders (' + after[name].ms + ' ms) with selectors');
+            });
+
+            //every change to a report re-rendered the list, now only the renamed row does
+            expect(before['report list'].renders).toBe(2 * EDITS + 1);
+            expect(after['report list'].renders).toBe(1);
+            //the form follows its own subsection and the open report, not comments elsewhere
+            expect(before['inspection form'].renders).toBe(2 * EDITS);
+            expect(after['inspection form'].renders).toBe(EDITS);
+        });
+    });
+});
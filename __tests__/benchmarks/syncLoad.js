@@ -0,0 +1,264 @@
+/**
+ * @jest-environment node
+ */
+jest.mock('react-native', () => {
+    let listeners = [];
+    return {
+        Dimensions: {get: () => ({width: 375, height: 667})},
+        Platform: {OS: 'ios'},
+        AppState: {addEventListener: () => {}, removeEventListener: () => {}},
+        InteractionManager: {runAfterInteractions: (callback) => callback()},
+        NetInfo: {
+            __setConnected: (connected) => listeners.forEach((listener) => listener(connected)),
+            isConnected: {
+                addEventListener: (name, listener) => listeners.push(listener),
+                removeEventListener: () => {},
+                fetch: () => Promise.resolve(false)
+            }
+        },
+        AsyncStorage: require.requireActual('react-native').AsyncStorage
+    };
+});
+jest.mock('react-native-background-timer', () => {
+    const timers = require('timers');
+    return {
+        setTimeout: (callback, ms) => timers.setTimeout(callback, ms),
+        clearTimeout: (timer) => timers.clearTimeout(timer)
+    };
+});
+//What the native side does: a body whose Content-Type ends in ;BASE64 is decoded and sent as bytes
+jest.mock('react-native-fetch-blob', () => {
+    const http = require('http');
+    const url = require('url');
+    const Buffer = require('buffer').Buffer;
+    return {
+        fetch: (method, target, headers, body) => new Promise((resolve, reject) => {
+            let sendHeaders = Object.assign({}, headers);
+            let bytes = Buffer.from(body || '', 'utf8');
+            if (/;base64$/i.test(sendHeaders['Content-Type'] || '')) {
+                sendHeaders['Content-Type'] = sendHeaders['Content-Type'].replace(/;base64$/i, '');
+                bytes = Buffer.from(body, 'base64');
+            }
+            let parts = url.parse(target);
+            let req = http.request({method: method, hostname: parts.hostname, port: parts.port, path: parts.path, headers: sendHeaders}, (res) => {
+                let chunks = [];
+                res.on('data', (chunk) => chunks.push(chunk));
+                res.on('end', () => {
+                    let text = Buffer.concat(chunks).toString('utf8');
+                    resolve({info: () => ({status: res.statusCode, headers: res.headers}), text: () => text});
+                });
+            });
+            req.on('error', reject);
+            req.end(bytes);
+        })
+    };
+});
+jest.mock('react-native-fabric', () => {
+    let events = [];
+    return {
+        Answers: {
+            __events: events,
+            logCustom: (name, attributes) => events.push({name: name, attributes: attributes})
+        }
+    };
+});
+
+import path from 'path';
+import { fork } from 'child_process';
+import axios from 'axios';
+import {
+    createStore,
+    applyMiddleware,
+    combineReducers
+} from 'redux';
+import thunk from 'redux-thunk';
+import {
+    NetInfo,
+    AsyncStorage
+} from 'react-native';
+import { Answers } from 'react-native-fabric';
+import data from '../../src/services/data.json';
+import Constant from '../../src/helper/constant';
+import SyncReducer from '../../src/reducers/syncReducer';
+import {
+    setUpdatedData,
+    postUpdatedData
+} from '../../src/actions/updatedAppDataAction';
+import { startSyncEngine } from '../../src/services/syncEngine';
+import { getSyncQueue } from '../../src/services/syncJournal';
+import { getQueueSize } from '../../src/services/syncQueue';
+
+//Replays synthetic offline sessions against the stand-in coordinator (scripts/mockCoordinator)
+//through the real sync path: journal, compaction, scheduler, engine, gzip, retries and
+//idempotency keys. Every session queues its operations offline, then the connection comes back
+//and the time to an empty queue, the bytes on the wire and the CPU of this process are reported.
+//Retry delays are shortened so that lossy sessions finish in seconds.
+//Runs with `npm run bench` (jest.bench.json), `npm test` leaves the benchmarks out.
+
+const SERVER_REPORTS = 40;
+const OFFLINE_REPORTS = 5;
+const SUBSECTIONS = 10;
+const EDITS_PER_SUBSECTION = 5;
+const IMAGES_PER_REPORT = 20;
+
+const SESSIONS = [
+    {name: 'fast network', latency: 20, jitter: 20, loss: 0},
+    {name: 'cellular with 5% loss', latency: 150, jitter: 150, loss: 0.05}
+];
+
+let nextOperationId = 1;
+
+//The fixture has few subsections, its sections stand in for them
+const getFixtureContent = () => {
+    let sections = data.reports.data[0].sections;
+    return {
+        comments: sections.map((section) => section.disclaimer_text).filter((text) => !!text),
+        subsections: sections.map((section) => ({id: section.id, name: section.name}))
+    };
+};
+
+const operation = (fields) => {
+    let id = nextOperationId++;
+    return Object.assign({operation_id: id, record_timestamp: id}, fields);
+};
+
+//Edits of one report as the inspection form queues them: every subsection saved several times,
+//photos taken, the inspection date changed
+const createReportSession = (report_id, content, isLocal) => {
+    let operations = [];
+    if (isLocal) {
+        operations.push(operation({resource: 'report', operation: 'INSERT', primary_key: report_id, isLocal: true,
+            data: {name: 'Offline report ' + report_id, template_id: 1, isLocal: true, id: report_id}}));
+    }
+    for (let edit = 0; edit < EDITS_PER_SUBSECTION; edit++) {
+        for (let i = 0; i < SUBSECTIONS; i++) {
+            let subsection = content.subsections[i % content.subsections.length];
+            operations.push(operation({
+                resource: 'formData',
+                operation: 'UPDATE',
+                primary_key: "" + report_id + subsection.id,
+                report_id: report_id,
+                data: {
+                    report_subsection_id: subsection.id,
+                    form_data: {name: subsection.name, note: 'edit ' + edit},
+                    comments: content.comments[(i + edit) % content.comments.length]
+                }
+            }));
+        }
+    }
+    for (let i = 0; i < IMAGES_PER_REPORT; i++) {
+        let image_id = 'img_' + report_id + '_' + i;
+        operations.push(operation({resource: 'images', operation: 'INSERT', primary_key: image_id, report_id: report_id, isLocal: true,
+            data: {id: image_id, report_subsection_id: content.subsections[i % SUBSECTIONS].id, original: 'file:///photos/' + image_id + '.jpg', isLocal: true}}));
+    }
+    operations.push(operation({resource: 'report', operation: 'UPDATE', primary_key: report_id, data: {inspection_date_time: '2018-02-01 10:00:00'}}));
+    return operations;
+};
+
+const createSession = () => {
+    let content = getFixtureContent();
+    let operations = [];
+    for (let i = 0; i < SERVER_REPORTS; i++) {
+        operations = operations.concat(createReportSession(1000 + i, content, false));
+    }
+    for (let i = 0; i < OFFLINE_REPORTS; i++) {
+        operations = operations.concat(createReportSession('local_' + Date.now() + '_' + i, content, true));
+    }
+    return operations;
+};
+
+const startCoordinator = (options) => new Promise((resolve, reject) => {
+    let args = ['--port', '0', '--latency', options.latency, '--jitter', options.jitter, '--loss', options.loss].map(String);
+    let child = fork(path.join(process.cwd(), 'scripts', 'mockCoordinator.js'), args, {silent: true});
+    child.once('message', (message) => resolve({child: child, url: message.url}));
+    child.once('error', reject);
+});
+
+const getStats = (coordinator) => new Promise((resolve) => {
+    coordinator.child.once('message', (message) => resolve(message.stats));
+    coordinator.child.send('stats');
+});
+
+const waitForDrain = (timeout) => new Promise((resolve, reject) => {
+    let start = Date.now();
+    const check = () => {
+        let event = Answers.__events.find((item) => item.name === 'Sync Drain');
+        if (event !== undefined) {
+            Answers.__events.splice(Answers.__events.indexOf(event), 1);
+            resolve(event.attributes);
+        } else if (Date.now() - start > timeout) {
+            reject(new Error('queue not drained, ' + getQueueSize(getSyncQueue()) + ' operations left'));
+        } else {
+            setTimeout(check, 20);
+        }
+    };
+    check();
+});
+
+describe('sync load', () => {
+
+    let store = null;
+
+    beforeAll(() => {
+        jest.setTimeout(5 * 60 * 1000);
+        axios.defaults.adapter = require('axios/lib/adapters/http');
+        Object.assign(Constant, {
+            syncRetryBase: 200,
+            syncRetryMax: 2000,
+            requestRetryBase: 100,
+            requestRetryMax: 500
+        });
+
+        store = createStore(combineReducers({
+            appAllData: (state = {reports: []}) => state,
+            sync: SyncReducer
+        }), applyMiddleware(thunk));
+        startSyncEngine((isRetry) => store.dispatch(postUpdatedData(isRetry)));
+        return AsyncStorage.setItem('user', JSON.stringify({token: 'benchmark'}));
+    });
+
+    SESSIONS.forEach((session) => {
+        it('drains an offline session on a ' + session.name, () => {
+            let coordinator = null;
+            let operations = createSession();
+            let cpu = null;
+
+            return startCoordinator(session)
+                .then((started) => {
+                    coordinator = started;
+                    Constant.baseurl = coordinator.url + '/api/v1/';
+                    return operations.reduce((chain, entry) => chain.then(() => store.dispatch(setUpdatedData(entry))), Promise.resolve());
+                })
+                .then(() => {
+                    let queued = getQueueSize(getSyncQueue());
+                    cpu = process.cpuUsage();
+                    NetInfo.__setConnected(true);
+                    return waitForDrain(4 * 60 * 1000).then((drain) => [queued, drain]);
+                })
+                .then(([queued, drain]) => {
+                    let cpuMs = Math.round(process.cpuUsage(cpu).user / 1000);
+                    NetInfo.__setConnected(false);
+                    return getStats(coordinator).then((stats) => {
+                        let applied = Object.keys(stats.applied).map((id) => stats.applied[id]);
+                        console.log(session.name + ': ' + operations.length + ' edits, ' + queued + ' queued after compaction, ' +
+                            drain.operations + ' acknowledged in ' + drain['drain ms'] + ' ms, ' + drain.bytes + ' bytes sent (' +
+                            stats.bytesIn + ' received by the server, ' + stats.gzipBodies + ' gzipped bodies), ' + cpuMs + ' ms CPU, ' + stats.requests + ' requests, ' +
+                            stats.dropped + ' dropped, ' + stats.replays + ' answered from the idempotency key');
+
+                        expect(getQueueSize(getSyncQueue())).toBe(0);
+                        //batches arrived gzipped and none fell back to a plain body
+                        expect(stats.gzipBodies).toBeGreaterThan(0);
+                        expect(Answers.__events.filter((event) => event.name === 'Gzip Refused')).toEqual([]);
+                        expect(drain.operations).toBe(queued);
+                        //lost answers were replayed, not applied again
+                        expect(Math.max.apply(null, applied)).toBe(1);
+                        expect(applied.length).toBe(queued);
+                    });
+                })
+                .then(() => coordinator.child.kill(), (error) => {
+                    coordinator && coordinator.child.kill();
+                    return Promise.reject(error);
+                });
+        });
+    });
+});
@@ -0,0 +1,52 @@
+import data from '../src/services/data.json';
+import {
+    encode,
+    decode
+} from '../src/services/compactJson';
+
+const roundTrip = (value) => decode(encode(value));
+
+describe('compactJson', () => {
+
+    it('round-trips the data.json fixture', () => {
+        expect(roundTrip(data)).toEqual(data);
+        expect(JSON.stringify(roundTrip(data))).toBe(JSON.stringify(data));
+    });
+
+    it('round-trips values of every kind', () => {
+        let values = [
+            null, true, 0, -1.5, '', 'text',
+            [], {}, [[]], [{}], {list: [-1, 1]},
+            {a: null, b: [null, false], c: {d: {e: 'deep'}}}
+        ];
+        values.forEach((value) => {
+            expect(roundTrip(value)).toEqual(value);
+        });
+    });
+
+    it('keeps strings that look like references', () => {
+        let value = {a: '~0', b: '~~', c: '~repeated', d: '~repeated', e: 'repeated', f: 'repeated'};
+        expect(roundTrip(value)).toEqual(value);
+    });
+
+    it('shares repeated keys and strings', () => {
+        let url = 'https://bucket.s3.amazonaws.com/image.jpg';
+        let images = [{original: url, isLocal: true}, {original: url, isLocal: false}];
+        let document = JSON.parse(encode(images));
+
+        expect(document[1]).toEqual(['original', 'isLocal']);
+        expect(document[2]).toEqual([url]);
+        expect(roundTrip(images)).toEqual(images);
+    });
+
+    it('writes what JSON.stringify writes for undefined, functions and dates', () => {
+        let date = new Date(Date.UTC(2018, 0, 31));
+        let value = {a: undefined, b: () => {}, c: [undefined, 1], d: date};
+        expect(roundTrip(value)).toEqual(JSON.parse(JSON.stringify(value)));
+    });
+
+    it('reads plain JSON written before the encoding', () => {
+        expect(decode(JSON.stringify(data))).toEqual(data);
+        expect(decode('["cj1"]')).toEqual(['cj1']);
+    });
+});
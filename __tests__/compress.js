@@ -0,0 +1,28 @@
+import pako from 'pako';
+import data from '../src/services/data.json';
+import {
+    gzipText,
+    toBase64
+} from '../src/services/compress';
+
+describe('compress', () => {
+
+    it('gzips text across chunks and surrogate pairs', () => {
+        let text = JSON.stringify(data) + '😀 é';
+        return gzipText(text).then((bytes) => {
+            expect(pako.ungzip(bytes, {to: 'string'})).toBe(text);
+        });
+    });
+
+    it('writes the base64 react-native-fetch-blob decodes', () => {
+        let bytes = new Uint8Array(256);
+        for (let i = 0; i < bytes.length; i++) {
+            bytes[i] = i;
+        }
+        for (let length = 0; length <= 6; length++) {
+            let slice = bytes.subarray(250 - length, 250);
+            expect(toBase64(slice)).toBe(Buffer.from(slice).toString('base64'));
+        }
+        expect(toBase64(bytes)).toBe(Buffer.from(bytes).toString('base64'));
+    });
+});
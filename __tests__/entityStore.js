@@ -0,0 +1,107 @@
+import {
+    createEntities,
+    normalizeReports,
+    normalizeComments,
+    setReportFields,
+    setSubsection,
+    setMedia,
+    getSubsectionEntity,
+    denormalizeReport
+} from '../src/services/entityStore';
+
+const createReport = (report_id) => {
+    return {
+        report_id: report_id,
+        name: 'Report ' + report_id,
+        property: {id: 1, address: 'Street'},
+        data: {
+            subsection_1: {
+                filedata: {id: 11},
+                comments: 'roof',
+                images: [{id: report_id * 100 + 1, original: 'a.jpg'}, {id: report_id * 100 + 2, original: 'b.jpg'}],
+                videos: [{id: report_id * 100 + 3, url: 'c.mp4'}]
+            },
+            subsection_2: {filedata: {id: 12}, images: []}
+        }
+    };
+};
+
+describe('entityStore', () => {
+
+    it('rebuilds the nested reports it was given', () => {
+        let reports = [createReport(1), createReport(2), {report_id: 3, name: 'Empty', data: []}];
+        let entities = normalizeReports(createEntities(), reports);
+
+        reports.forEach((report) => {
+            expect(denormalizeReport(entities, report.report_id)).toEqual(report);
+        });
+        expect(getSubsectionEntity(entities, 1, 'subsection_1')).toEqual({filedata: {id: 11}, comments: 'roof'});
+        expect(entities.reportPosition).toEqual({1: 0, 2: 1, 3: 2});
+        expect(denormalizeReport(entities, 4)).toBeUndefined();
+    });
+
+    it('keeps local media whose timestamp ids repeat apart', () => {
+        let report = createReport(1);
+        report.data.subsection_2.images = [{id: 5, isLocal: true}, {id: 5, isLocal: true, original: 'd.jpg'}];
+        let entities = normalizeReports(createEntities(), [report]);
+
+        expect(denormalizeReport(entities, 1)).toEqual(report);
+    });
+
+    it('rebuilds only the reports that changed', () => {
+        let reports = [createReport(1), createReport(2)];
+        let entities = normalizeReports(createEntities(), reports);
+        let first = getSubsectionEntity(entities, 1, 'subsection_1');
+
+        expect(normalizeReports(entities, reports).subsectionData).toBe(entities.subsectionData);
+
+        let changed = Object.assign({}, reports[1], {name: 'Renamed'});
+        let next = normalizeReports(entities, [reports[0], changed]);
+        expect(getSubsectionEntity(next, 1, 'subsection_1')).toBe(first);
+        expect(denormalizeReport(next, 2)).toEqual(changed);
+
+        next = normalizeReports(next, [changed]);
+        expect(denormalizeReport(next, 1)).toBeUndefined();
+        expect(getSubsectionEntity(next, 1, 'subsection_1')).toBeUndefined();
+        expect(next.reportPosition).toEqual({2: 0});
+    });
+
+    it('applies point updates the way normalizing the changed report does', () => {
+        let report = createReport(1);
+        let entities = normalizeReports(createEntities(), [report]);
+        let image = {id: 'local_img', original: 'e.jpg', isLocal: true};
+        let video = {id: 103, url: 'f.mp4'};
+
+        entities = setReportFields(entities, 1, {inspection_date_time: '2018-02-01 10:00:00'});
+        entities = setSubsection(entities, 1, 'subsection_2', {filedata: {id: 12}, comments: 'walls', images: []});
+        entities = setMedia(entities, 1, 'subsection_3', 'images', undefined, image);
+        entities = setMedia(entities, 1, 'subsection_1', 'images', 0, undefined);
+        entities = setMedia(entities, 1, 'subsection_1', 'videos', 0, video);
+
+        let expected = Object.assign({}, report, {inspection_date_time: '2018-02-01 10:00:00'});
+        expected.data = {
+            subsection_1: Object.assign({}, report.data.subsection_1, {images: report.data.subsection_1.images.slice(1), videos: [video]}),
+            subsection_2: {filedata: {id: 12}, comments: 'walls', images: []},
+            subsection_3: {images: [image]}
+        };
+        expect(denormalizeReport(entities, 1)).toEqual(expected);
+        expect(denormalizeReport(normalizeReports(createEntities(), [expected]), 1)).toEqual(expected);
+    });
+
+    it('ignores updates of unknown reports and media', () => {
+        let entities = normalizeReports(createEntities(), [createReport(1)]);
+
+        expect(setReportFields(entities, 9, {name: 'x'})).toBe(entities);
+        expect(setSubsection(entities, 9, 'subsection_1', {})).toBe(entities);
+        expect(setMedia(entities, 1, 'subsection_1', 'images', 5, {id: 1})).toBe(entities);
+        expect(setMedia(entities, 1, 'subsection_4', 'videos', 0, undefined)).toBe(entities);
+    });
+
+    it('indexes comments by subsection', () => {
+        let comments = {subsection_1: [{id: 1, text: 'a'}, {id: 2, text: 'b'}], subsection_2: []};
+        let entities = normalizeComments(createEntities(), comments);
+
+        expect(entities.commentsBySubsection).toEqual({subsection_1: [1, 2], subsection_2: []});
+        expect(entities.comments[2]).toBe(comments.subsection_1[1]);
+    });
+});
@@ -0,0 +1,106 @@
+import {
+    updateIn,
+    setIn,
+    pushIn,
+    removeIn
+} from '../src/services/immutable';
+import {
+    createStore,
+    applyMiddleware,
+    combineReducers
+} from 'redux';
+import thunk from 'redux-thunk';
+import { SET_ALL_REPORTS } from '../src/actions/type';
+import EntitiesReducer from '../src/reducers/entitiesReducer';
+import ReportReducer from '../src/reducers/reportReducer';
+import {
+    updateReportImage,
+    addReportVideo
+} from '../src/actions/reportFormDataAction';
+import { denormalizeReport } from '../src/services/entityStore';
+
+const createReport = () => {
+    return {
+        report_id: 1,
+        property: {id: 1, address: 'Street'},
+        data: {
+            subsection_1: {filedata: {id: 11}, images: [{id: 1}, {id: 2}]},
+            subsection_2: {filedata: {id: 12}, images: []}
+        }
+    };
+};
+
+describe('immutable', () => {
+
+    it('copies only the path to the changed value', () => {
+        let report = createReport();
+        let image = {id: 3};
+        let next = setIn(report, ['data', 'subsection_1', 'images', 1], image);
+
+        expect(next).not.toBe(report);
+        expect(next.data).not.toBe(report.data);
+        expect(next.data.subsection_1).not.toBe(report.data.subsection_1);
+        expect(next.data.subsection_1.images).toEqual([{id: 1}, image]);
+
+        expect(next.property).toBe(report.property);
+        expect(next.data.subsection_2).toBe(report.data.subsection_2);
+        expect(next.data.subsection_1.filedata).toBe(report.data.subsection_1.filedata);
+        expect(next.data.subsection_1.images[0]).toBe(report.data.subsection_1.images[0]);
+    });
+
+    it('leaves the previous state untouched', () => {
+        let report = createReport();
+        let snapshot = JSON.parse(JSON.stringify(report));
+
+        setIn(report, ['property', 'address'], 'Other street');
+        pushIn(report, ['data', 'subsection_2', 'images'], {id: 4});
+        removeIn(report, ['data', 'subsection_1', 'images'], 0);
+
+        expect(report).toEqual(snapshot);
+    });
+
+    it('returns the same object when nothing changed', () => {
+        let report = createReport();
+
+        expect(setIn(report, ['property'], report.property)).toBe(report);
+        expect(updateIn(report, ['data', 'subsection_1'], (subsection) => subsection)).toBe(report);
+        expect(removeIn(report, ['data', 'subsection_1', 'images'], 5)).toBe(report);
+    });
+
+    it('creates missing objects and arrays on the path', () => {
+        let next = setIn({}, ['data', 'subsection_3', 'images', 0], {id: 5});
+
+        expect(next.data.subsection_3.images).toEqual([{id: 5}]);
+        expect(Array.isArray(next.data.subsection_3.images)).toBe(true);
+        expect(pushIn({}, ['videos'], {id: 6})).toEqual({videos: [{id: 6}]});
+    });
+
+    it('shares the elements of copied arrays', () => {
+        let report = createReport();
+        let images = report.data.subsection_1.images;
+        let pushed = pushIn(report, ['data', 'subsection_1', 'images'], {id: 7});
+        let removed = removeIn(report, ['data', 'subsection_1', 'images'], 0);
+
+        expect(pushed.data.subsection_1.images.slice(0, 2)).toEqual(images);
+        expect(pushed.data.subsection_1.images[1]).toBe(images[1]);
+        expect(removed.data.subsection_1.images).toHaveLength(1);
+        expect(removed.data.subsection_1.images[0]).toBe(images[1]);
+    });
+
+    it('adds media to a report whose empty data came as an array', () => {
+        let store = createStore(combineReducers({
+            appAllData: (state = {reports: []}, action) => (action.type === SET_ALL_REPORTS) ? {reports: action.payload} : state,
+            report: ReportReducer,
+            entities: EntitiesReducer
+        }), applyMiddleware(thunk));
+        store.dispatch({type: SET_ALL_REPORTS, payload: [{report_id: 1, data: []}]});
+
+        return store.dispatch(updateReportImage({id: 8}, 1, 3))
+            .then(() => store.dispatch(addReportVideo({id: 9}, 1, 3)))
+            .then(() => {
+                let report = JSON.parse(JSON.stringify(store.getState().appAllData.reports[0]));
+                expect(report.data).toEqual({subsection_3: {images: [{id: 8}], videos: [{id: 9}]}});
+                expect(denormalizeReport(store.getState().entities, 1)).toEqual(report);
+            });
+    });
+});
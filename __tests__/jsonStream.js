@@ -0,0 +1,69 @@
+import { createJsonStream } from '../src/services/jsonStream';
+
+const DOCUMENT = {
+    reports: [
+        {report_id: 1, name: 'Report "one"', data: {subsection_1: {images: [{id: 1}], note: 'a, b ] }'}}},
+        {report_id: 2, name: 'back\\slash', property: null, done: true},
+        {report_id: 3, data: [], values: [1.5, -2, 3e2]}
+    ],
+    schema: {templates: [{template_id: 1, name: 'Template'}]},
+    skipped: {reports: [{report_id: 4}]},
+    cursor: '2018-01-31T10:00:00Z',
+    count: 3
+};
+
+const SELECTORS = {
+    'reports[]': true,
+    'schema.templates': true,
+    'cursor': true,
+    'count': true
+};
+
+const EXPECTED = [
+    ['reports[]', DOCUMENT.reports[0]],
+    ['reports[]', DOCUMENT.reports[1]],
+    ['reports[]', DOCUMENT.reports[2]],
+    ['schema.templates', DOCUMENT.schema.templates],
+    ['cursor', DOCUMENT.cursor],
+    ['count', DOCUMENT.count]
+];
+
+const read = (chunks) => {
+    let values = [];
+    let stream = createJsonStream(SELECTORS, (path, value) => values.push([path, value]));
+    chunks.forEach((chunk) => stream.write(chunk));
+    stream.end();
+    return values;
+};
+
+describe('jsonStream', () => {
+
+    it('reads the selected values of a document written at once', () => {
+        expect(read([JSON.stringify(DOCUMENT)])).toEqual(EXPECTED);
+        expect(read([JSON.stringify(DOCUMENT, null, 2)])).toEqual(EXPECTED);
+    });
+
+    it('reads the same values whatever the chunk boundaries', () => {
+        let text = JSON.stringify(DOCUMENT, null, 1);
+        for (let i = 1; i < text.length; i++) {
+            let values = read([text.slice(0, i), text.slice(i)]);
+            if (JSON.stringify(values) !== JSON.stringify(EXPECTED)) {
+                throw new Error('values differ when split at ' + i + ': ' + JSON.stringify(text.slice(i - 5, i + 5)));
+            }
+        }
+    });
+
+    it('reads a document written one character at a time', () => {
+        expect(read(JSON.stringify(DOCUMENT).split(''))).toEqual(EXPECTED);
+    });
+
+    it('calls back with a number at the end of the input on end()', () => {
+        let values = [];
+        let stream = createJsonStream({'count': true}, (path, value) => values.push(value));
+        stream.write('{"count":1');
+        stream.write('2');
+        expect(values).toEqual([]);
+        stream.end();
+        expect(values).toEqual([12]);
+    });
+});
@@ -0,0 +1,153 @@
+import Constant from '../src/helper/constant';
+import {
+    schedule,
+    PRIORITY_INTERACTIVE,
+    PRIORITY_BACKGROUND,
+    PRIORITY_TRANSFER
+} from '../src/services/requestScheduler';
+
+//Tasks that record when they start and finish when the test answers them
+const createTasks = () => {
+    let started = [];
+    let answers = {};
+    return {
+        started: started,
+        task: (name) => () => new Promise((resolve, reject) => {
+            started.push(name);
+            answers[name] = {resolve: resolve, reject: reject};
+        }),
+        resolve: (name) => answers[name].resolve(name),
+        reject: (name) => answers[name].reject(new Error(name))
+    };
+};
+
+const wait = (ms = 0) => new Promise((resolve) => setTimeout(resolve, ms));
+
+describe('requestScheduler', () => {
+
+    let defaults = null;
+
+    beforeEach(() => {
+        defaults = {
+            requestLimits: Constant.requestLimits,
+            requestYieldMax: Constant.requestYieldMax
+        };
+        Constant.requestLimits = {interactive: 2, background: 1, transfer: 1};
+    });
+
+    afterEach(() => {
+        Object.assign(Constant, defaults);
+    });
+
+    it('runs at most requestLimits tasks of a class at once', () => {
+        let tasks = createTasks();
+        let results = ['a', 'b', 'c'].map((name) => schedule(PRIORITY_INTERACTIVE, tasks.task(name)));
+
+        expect(tasks.started).toEqual(['a', 'b']);
+        tasks.resolve('a');
+        return results[0]
+            .then((result) => {
+                expect(result).toBe('a');
+                return wait();
+            })
+            .then(() => {
+                expect(tasks.started).toEqual(['a', 'b', 'c']);
+                tasks.resolve('b');
+                tasks.resolve('c');
+                return Promise.all(results);
+            });
+    });
+
+    it('holds background and transfer tasks while interactive requests are busy', () => {
+        let tasks = createTasks();
+        let screen = schedule(PRIORITY_INTERACTIVE, tasks.task('screen'));
+        let sync = schedule(PRIORITY_BACKGROUND, tasks.task('sync'));
+        let upload = schedule(PRIORITY_TRANSFER, tasks.task('upload'));
+
+        expect(tasks.started).toEqual(['screen']);
+        tasks.resolve('screen');
+        return screen
+            .then(() => wait())
+            .then(() => {
+                expect(tasks.started).toEqual(['screen', 'sync', 'upload']);
+                tasks.resolve('sync');
+                tasks.resolve('upload');
+                return Promise.all([sync, upload]);
+            });
+    });
+
+    it('lets a running upload finish when a screen request arrives', () => {
+        let tasks = createTasks();
+        let upload = schedule(PRIORITY_TRANSFER, tasks.task('upload'));
+        let next = schedule(PRIORITY_TRANSFER, tasks.task('next upload'));
+        let screen = schedule(PRIORITY_INTERACTIVE, tasks.task('screen'));
+
+        expect(tasks.started).toEqual(['upload', 'screen']);
+        tasks.resolve('upload');
+        return upload
+            .then(() => wait())
+            .then(() => {
+                //the queued upload waits for the screen request
+                expect(tasks.started).toEqual(['upload', 'screen']);
+                tasks.resolve('screen');
+                return screen.then(() => wait());
+            })
+            .then(() => {
+                expect(tasks.started).toEqual(['upload', 'screen', 'next upload']);
+                tasks.resolve('next upload');
+                return next;
+            });
+    });
+
+    it('starts held back tasks after requestYieldMax so they are not starved', () => {
+        Constant.requestYieldMax = 20;
+        let tasks = createTasks();
+        let screen = schedule(PRIORITY_INTERACTIVE, tasks.task('screen'));
+        let sync = schedule(PRIORITY_BACKGROUND, tasks.task('sync'));
+
+        expect(tasks.started).toEqual(['screen']);
+        return wait(40)
+            .then(() => {
+                expect(tasks.started).toEqual(['screen', 'sync']);
+                tasks.resolve('screen');
+                tasks.resolve('sync');
+                return Promise.all([screen, sync]);
+            });
+    });
+
+    it('frees the slot of a task that fails or throws', () => {
+        let tasks = createTasks();
+        let failed = schedule(PRIORITY_BACKGROUND, tasks.task('failed'));
+        let thrown = schedule(PRIORITY_BACKGROUND, () => {
+            throw new Error('thrown');
+        });
+        let last = schedule(PRIORITY_BACKGROUND, tasks.task('last'));
+
+        tasks.reject('failed');
+        return Promise.all([failed, thrown].map((result) => result.then(() => 'ok', (error) => error.message)))
+            .then((results) => {
+                expect(results).toEqual(['failed', 'thrown']);
+                expect(tasks.started).toEqual(['failed', 'last']);
+                tasks.resolve('last');
+                return last;
+            });
+    });
+
+    it('runs tasks of an unknown class as interactive', () => {
+        let tasks = createTasks();
+        let sync = schedule(PRIORITY_BACKGROUND, tasks.task('sync'));
+        let other = schedule('unknown', tasks.task('other'));
+        let held = schedule(PRIORITY_BACKGROUND, tasks.task('held'));
+
+        expect(tasks.started).toEqual(['sync', 'other']);
+        tasks.resolve('sync');
+        tasks.resolve('other');
+        return Promise.all([sync, other])
+            .then(() => wait())
+            .then(() => {
+                expect(tasks.started).toEqual(['sync', 'other', 'held']);
+                tasks.resolve('held');
+                return held;
+            });
+    });
+});
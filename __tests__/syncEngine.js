@@ -0,0 +1,170 @@
+jest.mock('react-native', () => {
+    let listeners = [];
+    return {
+        Dimensions: {get: () => ({width: 375, height: 667})},
+        Platform: {OS: 'ios'},
+        NetInfo: {
+            __setConnected: (connected) => listeners.forEach((listener) => listener(connected)),
+            isConnected: {
+                addEventListener: (name, listener) => listeners.push(listener),
+                removeEventListener: () => {},
+                fetch: () => Promise.resolve(false)
+            }
+        },
+        AppState: {
+            addEventListener: () => {},
+            removeEventListener: () => {}
+        }
+    };
+});
+//Timers run only when the test fires them
+jest.mock('react-native-background-timer', () => {
+    let timers = {};
+    let nextTimer = 1;
+    return {
+        __timers: timers,
+        __fire: () => {
+            Object.keys(timers).forEach((id) => {
+                let timer = timers[id];
+                delete timers[id];
+                timer.callback();
+            });
+        },
+        setTimeout: (callback, ms) => {
+            let id = nextTimer++;
+            timers[id] = {callback: callback, ms: ms};
+            return id;
+        },
+        clearTimeout: (id) => {
+            delete timers[id];
+        }
+    };
+});
+jest.mock('../src/services/syncTelemetry', () => ({
+    recordRetry: () => {},
+    recordReconnect: () => {},
+    flushTelemetry: () => {}
+}));
+
+import { NetInfo } from 'react-native';
+import BackgroundTimer from 'react-native-background-timer';
+import Constant from '../src/helper/constant';
+import {
+    startSyncEngine,
+    stopSyncEngine,
+    wakeSyncEngine
+} from '../src/services/syncEngine';
+
+const wait = () => new Promise((resolve) => setTimeout(resolve, 0));
+
+const getDelays = () => {
+    return Object.keys(BackgroundTimer.__timers).map((id) => BackgroundTimer.__timers[id].ms);
+};
+
+describe('syncEngine', () => {
+
+    let drains = [];
+    let answer = null;      //(isRetry) => array of batch results, true, false or an Error
+
+    beforeAll(() => {
+        startSyncEngine((isRetry) => {
+            drains.push(isRetry);
+            return Promise.resolve(answer(isRetry).map((result) => {
+                return (result instanceof Error) ? Promise.reject(result) : Promise.resolve(result);
+            }));
+        });
+        jest.spyOn(Math, 'random').mockImplementation(() => 1);
+        jest.spyOn(console, 'log').mockImplementation(() => {});
+    });
+
+    afterAll(() => {
+        stopSyncEngine();
+        Math.random.mockRestore();
+        console.log.mockRestore();
+    });
+
+    beforeEach(() => {
+        NetInfo.__setConnected(false);
+        drains = [];
+        answer = () => [];
+    });
+
+    it('drains once the connection is back and sends held back operations', () => {
+        wakeSyncEngine();
+        expect(drains).toEqual([]);
+
+        NetInfo.__setConnected(true);
+        expect(drains).toEqual([true]);
+        return wait().then(() => {
+            wakeSyncEngine();
+            expect(drains).toEqual([true, false]);
+        });
+    });
+
+    it('folds the wakes of a running drain into one more drain', () => {
+        NetInfo.__setConnected(true);
+        wakeSyncEngine();
+        wakeSyncEngine(true);
+        expect(drains).toEqual([true]);
+
+        return wait().then(() => {
+            expect(drains).toEqual([true, true]);
+        });
+    });
+
+    //Only retries send the held back operations, ordinary drains find nothing to send
+    it('backs off exponentially up to syncRetryMax and sends again on the retry', () => {
+        answer = (isRetry) => isRetry ? [new Error('offline')] : [];
+        NetInfo.__setConnected(true);
+        let delays = [];
+
+        const step = () => wait().then(() => {
+            delays = delays.concat(getDelays());
+            BackgroundTimer.__fire();
+        });
+
+        let chain = Promise.resolve();
+        for (let i = 0; i < 10; i++) {
+            chain = chain.then(step);
+        }
+        return chain.then(() => {
+            let expected = [0, 1, 2, 3, 4, 5, 6, 7, 8, 9].map((i) => Math.min(Constant.syncRetryMax, Constant.syncRetryBase * Math.pow(2, i)));
+            expect(delays).toEqual(expected);
+            //the drain on reconnect and one per retry
+            expect(drains.filter((isRetry) => isRetry)).toHaveLength(11);
+        });
+    });
+
+    it('starts again from syncRetryBase after a batch is acknowledged', () => {
+        let results = [[false], [true, false]];
+        answer = (isRetry) => isRetry ? results.shift() : [];
+        NetInfo.__setConnected(true);
+
+        return wait()
+            .then(() => {
+                expect(getDelays()).toEqual([Constant.syncRetryBase]);
+                BackgroundTimer.__fire();
+                return wait();
+            })
+            .then(() => {
+                expect(getDelays()).toEqual([Constant.syncRetryBase]);
+            });
+    });
+
+    it('keeps a scheduled retry when the queue wakes the engine', () => {
+        answer = (isRetry) => isRetry ? [false] : [];
+        NetInfo.__setConnected(true);
+
+        return wait()
+            .then(() => {
+                wakeSyncEngine();
+                return wait();
+            })
+            .then(() => {
+                expect(getDelays()).toHaveLength(1);
+                expect(drains[drains.length - 1]).toBe(false);
+                BackgroundTimer.__fire();
+                expect(drains[drains.length - 1]).toBe(true);
+            });
+    });
+});
@@ -0,0 +1,23 @@
+import RNFS from 'react-native-fs';
+import {
+    loadSyncJournal,
+    getSyncQueue
+} from '../src/services/syncJournal';
+import { toArray } from '../src/services/syncQueue';
+
+describe('syncJournal', () => {
+
+    it('recovers the queue from the temp checkpoint when a crash removed the checkpoint', () => {
+        let first = {operation_id: 1, resource: 'report', operation: 'UPDATE', primary_key: 1};
+        let second = {operation_id: 2, resource: 'report', operation: 'UPDATE', primary_key: 2};
+
+        //the old checkpoint is gone, the new one was not moved in place yet
+        RNFS.__files['/documents/syncQueue.checkpoint.tmp'] = JSON.stringify({seq: 1, operations: {1: first}});
+        RNFS.__files['/documents/syncQueue.journal'] = JSON.stringify({s: 2, o: second}) + '\n';
+
+        return loadSyncJournal().then(() => {
+            expect(toArray(getSyncQueue())).toEqual([first, second]);
+            expect(getSyncQueue().seq).toBe(2);
+        });
+    });
+});
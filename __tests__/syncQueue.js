@@ -0,0 +1,135 @@
+import {
+    createQueue,
+    enqueue,
+    compactOperation,
+    removeOperation,
+    findOperation,
+    getQueueSize,
+    getReportOperations,
+    setQueueObserver,
+    toArray
+} from '../src/services/syncQueue';
+
+let nextId = 1;
+
+const operation = (fields) => {
+    return Object.assign({operation_id: nextId++, record_timestamp: nextId}, fields);
+};
+
+const report = (operationType, id, fields) => {
+    return operation(Object.assign({resource: 'report', operation: operationType, primary_key: id}, fields));
+};
+
+const image = (operationType, id, reportId, fields) => {
+    return operation(Object.assign({resource: 'images', operation: operationType, primary_key: id, report_id: reportId}, fields));
+};
+
+const compactAll = (operations, inFlight) => {
+    return operations.reduce((queue, entry) => compactOperation(queue, entry, inFlight), createQueue());
+};
+
+describe('syncQueue', () => {
+
+    afterEach(() => {
+        setQueueObserver(null);
+    });
+
+    it('keeps operations in FIFO order and finds them by operation_id', () => {
+        let first = report('UPDATE', 1);
+        let second = report('UPDATE', 2);
+        let queue = enqueue(enqueue(createQueue(), first), second);
+
+        expect(toArray(queue)).toEqual([first, second]);
+        expect(getQueueSize(queue)).toBe(2);
+        expect(findOperation(queue, second.operation_id)).toBe(second);
+
+        queue = removeOperation(queue, first.operation_id);
+        expect(toArray(queue)).toEqual([second]);
+        expect(findOperation(queue, first.operation_id)).toBeUndefined();
+    });
+
+    it('hands out a new queue object on every change', () => {
+        let queue = createQueue();
+        let next = enqueue(queue, report('UPDATE', 1));
+
+        expect(next).not.toBe(queue);
+        expect(removeOperation(next, -1)).toBe(next);
+    });
+
+    it('folds an UPDATE into the queued INSERT of the same entity', () => {
+        let insert = report('INSERT', 'local_1', {data: {name: 'a', id: 'local_1', isLocal: true}});
+        let update = report('UPDATE', 'local_1', {data: {city: 'b'}});
+        let queue = compactAll([insert, update]);
+
+        let operations = toArray(queue);
+        expect(operations).toHaveLength(1);
+        expect(operations[0].operation).toBe('INSERT');
+        expect(operations[0].operation_id).toBe(insert.operation_id);
+        expect(operations[0].data).toEqual({name: 'a', city: 'b'});
+        expect(operations[0].record_timestamp).toBe(update.record_timestamp);
+    });
+
+    it('keeps only the latest of successive UPDATEs in the place of the first', () => {
+        let other = report('UPDATE', 2);
+        let first = report('UPDATE', 1, {data: {name: 'a'}});
+        let last = report('UPDATE', 1, {data: {name: 'b'}});
+        let queue = compactAll([first, other, last]);
+
+        expect(toArray(queue)).toEqual([last, other]);
+    });
+
+    it('cancels a queued INSERT and its DELETE, with the children of a report', () => {
+        let insert = report('INSERT', 'local_1', {data: {}});
+        let child = image('INSERT', 'img_1', 'local_1', {data: {}});
+        let unrelated = image('INSERT', 'img_2', 7, {data: {}});
+        let remove = operation({resource: 'report', operation: 'DELETE', id: 'local_1', isLocal: true});
+        let queue = compactAll([insert, child, unrelated, remove]);
+
+        expect(toArray(queue)).toEqual([unrelated]);
+        expect(getReportOperations(queue, 'local_1')).toEqual([]);
+    });
+
+    it('drops the DELETE of an entity that never reached the server', () => {
+        let remove = operation({resource: 'images', operation: 'DELETE', id: 'img_1', report_id: 7, isLocal: true});
+        expect(getQueueSize(compactAll([remove]))).toBe(0);
+    });
+
+    it('replaces queued UPDATEs of a synced entity by its DELETE', () => {
+        let update = report('UPDATE', 3, {data: {name: 'a'}});
+        let remove = operation({resource: 'report', operation: 'DELETE', id: 3});
+        let operations = toArray(compactAll([update, remove]));
+
+        expect(operations).toHaveLength(1);
+        expect(operations[0].operation).toBe('DELETE');
+        expect(operations[0].isLocal).toBeUndefined();
+    });
+
+    it('never changes operations in flight', () => {
+        let insert = report('INSERT', 'local_1', {data: {name: 'a'}});
+        let inFlight = {[insert.operation_id]: true};
+        let update = report('UPDATE', 'local_1', {data: {name: 'b'}});
+        let queue = compactAll([insert, update], inFlight);
+
+        expect(toArray(queue)).toEqual([insert, update]);
+
+        //the INSERT may already be on the server, the DELETE has to be sent
+        let remove = operation({resource: 'report', operation: 'DELETE', id: 'local_1', isLocal: true});
+        queue = compactOperation(queue, remove, inFlight);
+        let operations = toArray(queue);
+        expect(operations).toHaveLength(2);
+        expect(operations[0]).toBe(insert);
+        expect(operations[1].operation).toBe('DELETE');
+        expect(operations[1].isLocal).toBeUndefined();
+    });
+
+    it('tells the observer about stored and removed operations', () => {
+        let calls = [];
+        setQueueObserver((seq, entry) => calls.push([seq, entry]));
+
+        let first = report('UPDATE', 1);
+        let queue = enqueue(createQueue(), first);
+        queue = removeOperation(queue, first.operation_id);
+
+        expect(calls).toEqual([[1, first], [1, undefined]]);
+    });
+});
@@ -0,0 +1,183 @@
+jest.mock('../src/services/apiCall', () => ({
+    CallAuthApi: jest.fn(),
+    getSentBytes: () => 0
+}));
+jest.mock('../src/services/syncEngine', () => ({
+    wakeSyncEngine: () => {}
+}));
+jest.mock('../src/services/syncTelemetry', () => ({
+    recordEnqueue: () => {},
+    recordBatch: () => {},
+    recordFailure: () => {},
+    recordDrained: () => {}
+}));
+jest.mock('../src/services/idMap', () => ({
+    loadIdMap: () => Promise.resolve({}),
+    getMappingKey: (operation) => operation.resource + '_' + operation.primary_key,
+    getMapping: () => undefined,
+    setMapping: jest.fn(() => Promise.resolve()),
+    resolveOperation: (operation) => operation
+}));
+
+import {
+    createStore,
+    applyMiddleware,
+    combineReducers
+} from 'redux';
+import thunk from 'redux-thunk';
+import SyncReducer from '../src/reducers/syncReducer';
+import { CallAuthApi } from '../src/services/apiCall';
+import { setMapping } from '../src/services/idMap';
+import { getSyncQueue } from '../src/services/syncJournal';
+import { findOperation } from '../src/services/syncQueue';
+import {
+    setUpdatedData,
+    postUpdatedData
+} from '../src/actions/updatedAppDataAction';
+
+let nextId = 1;
+
+const update = (report_id, fields) => {
+    let id = nextId++;
+    return {operation_id: id, record_timestamp: id, resource: 'report', operation: 'UPDATE', primary_key: report_id, data: fields};
+};
+
+const createAppStore = () => {
+    return createStore(combineReducers({
+        appAllData: (state = {reports: []}) => state,
+        sync: SyncReducer
+    }), applyMiddleware(thunk));
+};
+
+//Posts what is ready and waits for every batch, failed ones included
+const post = (store, isRetry) => {
+    return store.dispatch(postUpdatedData(isRetry)).then((batches) => {
+        return Promise.all(batches.map((batch) => batch.then((value) => value, () => 'failed')));
+    });
+};
+
+const wait = () => new Promise((resolve) => setTimeout(resolve, 0));
+
+const lastCall = () => CallAuthApi.mock.calls[CallAuthApi.mock.calls.length - 1];
+
+const acknowledge = () => {
+    CallAuthApi.mockImplementation((url, type, payload) => Promise.resolve({
+        data: payload.map((operation) => ({operation_id: operation.operation_id, status: 1}))
+    }));
+};
+
+const reject = (response) => {
+    CallAuthApi.mockImplementation(() => {
+        let error = new Error('failed');
+        error.response = response;
+        return Promise.reject(error);
+    });
+};
+
+describe('sync retries', () => {
+
+    afterEach(() => {
+        CallAuthApi.mockReset();
+        setMapping.mockImplementation(() => Promise.resolve());
+    });
+
+    it('resends a batch without answer as it was, with the same idempotency key', () => {
+        let store = createAppStore();
+        let first = update(1, {name: 'a'});
+        let sent = null;
+
+        reject(undefined);
+        return store.dispatch(setUpdatedData(first))
+            .then(() => post(store, false))
+            .then((results) => {
+                expect(results).toEqual(['failed']);
+                sent = lastCall();
+
+                //not folded into the batch the server may have committed
+                return store.dispatch(setUpdatedData(update(1, {name: 'b'})));
+            })
+            .then(() => post(store, false))
+            .then((results) => {
+                expect(results).toEqual([]);
+                acknowledge();
+                return post(store, true);
+            })
+            .then((results) => {
+                expect(results).toEqual([true]);
+                expect(lastCall()[2]).toEqual(sent[2]);
+                expect(lastCall()[4].idempotencyKey).toBe(sent[4].idempotencyKey);
+                expect(lastCall()[2]).toEqual([first]);
+                return post(store, false);
+            })
+            .then((results) => {
+                expect(results).toEqual([true]);
+                expect(lastCall()[2][0].data).toEqual({name: 'b'});
+            });
+    });
+
+    it('resends a batch answered with 409 on retry without holding back other reports', () => {
+        let store = createAppStore();
+        let operation = update(2, {name: 'c'});
+        let sent = null;
+
+        reject({status: 409, data: {}});
+        return store.dispatch(setUpdatedData(operation))
+            .then(() => post(store, false))
+            .then((results) => {
+                //not counted as acknowledged, the engine backs off
+                expect(results).toEqual(['failed']);
+                sent = lastCall();
+                acknowledge();
+                return store.dispatch(setUpdatedData(update(3, {name: 'd'})));
+            })
+            .then(() => post(store, false))
+            .then((results) => {
+                expect(results).toEqual([true]);
+                expect(lastCall()[2][0].primary_key).toBe(3);
+                return post(store, true);
+            })
+            .then((results) => {
+                expect(results).toEqual([true]);
+                expect(lastCall()[2]).toEqual([operation]);
+                expect(lastCall()[4].idempotencyKey).toBe(sent[4].idempotencyKey);
+                return post(store, false);
+            })
+            .then((results) => {
+                expect(results).toEqual([]);
+            });
+    });
+
+    it('keeps an acknowledged INSERT queued until its id mapping is stored', () => {
+        let store = createAppStore();
+        let id = nextId++;
+        let insert = {operation_id: id, record_timestamp: id, resource: 'report', operation: 'INSERT', primary_key: 'local_1', isLocal: true, data: {name: 'e'}};
+        let storeMapping = null;
+        let answered = null;
+
+        acknowledge();
+        setMapping.mockImplementation(() => new Promise((resolve) => {
+            storeMapping = resolve;
+        }));
+        return store.dispatch(setUpdatedData(insert))
+            .then(() => store.dispatch(postUpdatedData(false)))
+            .then((batches) => {
+                answered = batches[0];
+                return wait();
+            })
+            .then(() => {
+                expect(storeMapping).not.toBe(null);
+                expect(findOperation(getSyncQueue(), id)).toEqual(insert);
+                //still in flight, not sent again meanwhile
+                return post(store, false);
+            })
+            .then((results) => {
+                expect(results).toEqual([]);
+                storeMapping();
+                return answered;
+            })
+            .then((isAcknowledged) => {
+                expect(isAcknowledged).toBe(true);
+                expect(findOperation(getSyncQueue(), id)).toBeUndefined();
+            });
+    });
+});
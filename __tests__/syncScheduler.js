@@ -0,0 +1,98 @@
+import Constant from '../src/helper/constant';
+import {
+    createQueue,
+    enqueue
+} from '../src/services/syncQueue';
+import {
+    getReadyOperations,
+    getSyncBatches
+} from '../src/services/syncScheduler';
+
+let nextId = 1;
+
+const operation = (fields) => {
+    return Object.assign({operation_id: nextId++, record_timestamp: nextId}, fields);
+};
+
+const report = (operationType, id, fields) => {
+    return operation(Object.assign({resource: 'report', operation: operationType, primary_key: id}, fields));
+};
+
+const image = (operationType, id, reportId, fields) => {
+    return operation(Object.assign({resource: 'images', operation: operationType, primary_key: id, report_id: reportId}, fields));
+};
+
+const queueOf = (operations) => {
+    return operations.reduce((queue, entry) => enqueue(queue, entry), createQueue());
+};
+
+const ids = (operations) => operations.map((entry) => entry.operation_id);
+
+describe('syncScheduler', () => {
+
+    let defaults = null;
+
+    beforeEach(() => {
+        defaults = {
+            syncBatchSize: Constant.syncBatchSize,
+            syncBatchBytes: Constant.syncBatchBytes
+        };
+    });
+
+    afterEach(() => {
+        Object.assign(Constant, defaults);
+    });
+
+    it('hands out operations in FIFO order, one per entity', () => {
+        let first = image('UPDATE', 1, 10);
+        let second = report('UPDATE', 10);
+        let again = image('UPDATE', 1, 10, {data: {name: 'b'}});
+        let third = image('UPDATE', 2, 10);
+
+        expect(ids(getReadyOperations(queueOf([first, second, again, third])))).toEqual(ids([first, second, third]));
+    });
+
+    it('holds the next operation of an entity while the earlier one is in flight', () => {
+        let first = image('UPDATE', 1, 10);
+        let second = image('UPDATE', 1, 10, {data: {name: 'b'}});
+        let other = image('UPDATE', 2, 10);
+        let queue = queueOf([first, second, other]);
+
+        expect(ids(getReadyOperations(queue, {[first.operation_id]: true}))).toEqual([other.operation_id]);
+    });
+
+    it('blocks the children of a report until its INSERT is acknowledged', () => {
+        let insert = report('INSERT', 'local_1', {isLocal: true});
+        let child = image('INSERT', 'img_1', 'local_1', {isLocal: true});
+        let sibling = image('INSERT', 'img_2', 20);
+        let queue = queueOf([insert, child, sibling]);
+
+        expect(ids(getReadyOperations(queue))).toEqual([insert.operation_id, sibling.operation_id]);
+        //in flight but not acknowledged yet, the children still wait
+        expect(ids(getReadyOperations(queue, {[insert.operation_id]: true}))).toEqual([sibling.operation_id]);
+        expect(ids(getReadyOperations(queueOf([child, sibling])))).toEqual([child.operation_id, sibling.operation_id]);
+    });
+
+    it('cuts a report into batches by count and by bytes', () => {
+        Constant.syncBatchSize = 2;
+        let operations = [1, 2, 3, 4, 5].map((id) => image('UPDATE', id, 10));
+
+        expect(getSyncBatches(queueOf(operations), {}, 10).map(ids)).toEqual([
+            ids(operations.slice(0, 2)), ids(operations.slice(2, 4)), ids(operations.slice(4))
+        ]);
+
+        Constant.syncBatchSize = 25;
+        Constant.syncBatchBytes = Math.max.apply(null, operations.map((entry) => JSON.stringify(entry).length)) * 3;
+        expect(getSyncBatches(queueOf(operations), {}, 10).map((batch) => batch.length)).toEqual([3, 2]);
+    });
+
+    it('gives every report a batch before a second one of the same report', () => {
+        Constant.syncBatchSize = 1;
+        let large = [1, 2, 3].map((id) => image('UPDATE', id, 10));
+        let small = image('UPDATE', 4, 20);
+        let last = image('UPDATE', 5, 30);
+
+        let batches = getSyncBatches(queueOf(large.concat([small, last])), {}, 4);
+        expect(batches.map(ids)).toEqual([[large[0].operation_id], [small.operation_id], [last.operation_id], [large[1].operation_id]]);
+    });
+});
@@ -0,0 +1,80 @@
+import {
+    compileTemplate,
+    compileTemplates,
+    getCompiledSection,
+    getCompiledSubsections,
+    getCompiledElements
+} from '../src/services/templateIndex';
+
+const element = (guid, order, fields) => Object.assign({guid: guid, order: order}, fields);
+
+const createTemplate = (template_id) => {
+    return {
+        template_id: template_id,
+        name: 'Template ' + template_id,
+        sections: [
+            {section_id: 2, order: 2, subsections: []},
+            {section_id: 1, order: 1, subsections: [
+                {subsection_id: 12, order: 2, form: {form_elements: [
+                    element('c', 3),
+                    element('a', 1, {default_value: 'yes', options: ['yes', 'no']}),
+                    element('b', 2, {default_value: null})
+                ]}},
+                {subsection_id: 11, order: 1},
+                {subsection_id: 13, order: 2, form: {form_elements: []}}
+            ]},
+            {section_id: 3, order: 2}
+        ]
+    };
+};
+
+describe('templateIndex', () => {
+
+    it('lists sections, subsections and form elements in their order', () => {
+        let compiled = compileTemplate(createTemplate(1));
+
+        expect(compiled.sectionList.map((section) => section.section_id)).toEqual([1, 2, 3]);
+        expect(getCompiledSubsections(compiled, 1).map((subsection) => subsection.subsection_id)).toEqual([11, 12, 13]);
+        expect(getCompiledElements(compiled, 12).map((item) => item.guid)).toEqual(['a', 'b', 'c']);
+    });
+
+    it('keeps the schema order of entries with the same order', () => {
+        let compiled = compileTemplate(createTemplate(1));
+
+        expect(compiled.sectionList.map((section) => section.section_id).slice(1)).toEqual([2, 3]);
+        expect(getCompiledSubsections(compiled, 1).map((subsection) => subsection.subsection_id).slice(1)).toEqual([12, 13]);
+    });
+
+    it('finds entries by id and collects options and defaults', () => {
+        let template = createTemplate(1);
+        let compiled = compileTemplate(template);
+
+        expect(getCompiledSection(compiled, 1)).toBe(template.sections[1]);
+        expect(compiled.subsections[11]).toBe(template.sections[1].subsections[1]);
+        expect(compiled.elementsByGuid.a.options).toEqual(['yes', 'no']);
+        expect(compiled.options.c).toEqual([]);
+        expect(compiled.defaults[12]).toEqual({a: 'yes'});
+        expect(getCompiledElements(compiled, 11)).toEqual([]);
+        expect(getCompiledSubsections(compiled, 3)).toEqual([]);
+        expect(getCompiledSection(undefined, 1)).toBeUndefined();
+    });
+
+    it('compiles only the templates that changed and keeps their position', () => {
+        let first = createTemplate(1);
+        let second = createTemplate(2);
+        let compiled = compileTemplates({}, [first, second]);
+
+        expect(compiled[1].position).toBe(0);
+        expect(compiled[2].position).toBe(1);
+
+        let changed = Object.assign({}, first, {name: 'Renamed'});
+        let next = compileTemplates(compiled, [second, changed]);
+
+        expect(next[2].source).toBe(second);
+        expect(next[2].sections).toBe(compiled[2].sections);
+        expect(next[2].position).toBe(0);
+        expect(next[1].source).toBe(changed);
+        expect(next[1].position).toBe(1);
+        expect(compileTemplates(next, [second, changed])[2]).toBe(next[2]);
+    });
+});
@@ -0,0 +1,41 @@
+import { AsyncStorage } from 'react-native';
+
+//In-memory AsyncStorage for every test, the one of the react-native preset answers every read with
+//nothing. Tests that mock react-native take it over with
+//  AsyncStorage: require.requireActual('react-native').AsyncStorage
+//and read what was stored in AsyncStorage.__items.
+
+const items = {};
+
+const get = (key) => items.hasOwnProperty(key) ? items[key] : null;
+
+Object.assign(AsyncStorage, {
+    __items: items,
+    getItem: (key) => Promise.resolve(get(key)),
+    setItem: (key, value) => {
+        items[key] = value;
+        return Promise.resolve();
+    },
+    mergeItem: (key, value) => {
+        items[key] = JSON.stringify(Object.assign(JSON.parse(get(key) || '{}'), JSON.parse(value)));
+        return Promise.resolve();
+    },
+    removeItem: (key) => {
+        delete items[key];
+        return Promise.resolve();
+    },
+    getAllKeys: () => Promise.resolve(Object.keys(items)),
+    multiGet: (keys) => Promise.resolve(keys.map((key) => [key, get(key)])),
+    multiSet: (pairs) => {
+        pairs.forEach(([key, value]) => {
+            items[key] = value;
+        });
+        return Promise.resolve();
+    },
+    multiRemove: (keys) => {
+        keys.forEach((key) => {
+            delete items[key];
+        });
+        return Promise.resolve();
+    }
+});
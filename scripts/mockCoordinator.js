@@ -0,0 +1,287 @@
+//Stand-in for the coordinator API, to run the app or the sync benchmark without staging.
+//
+//  node scripts/mockCoordinator.js [--port 3000] [--latency 150] [--jitter 100] [--loss 0.02]
+//  npm run coordinator -- --latency 150
+//
+//Point Constant.baseurl at http://<host>:<port>/api/v1/ and Constant.mediaHost at
+//http://<host>:<port>/s3. The reports and templates of src/services/data.json are served, and
+//what the app syncs is applied to them in memory.
+//  GET  /api/v1/reporttemplate/export[?since=<cursor>]     full export, or the reports changed since a cursor (410 when unknown)
+//  POST /api/v1/coordinator/sync/data                      answers one result per operation (status 1), INSERTs get ids
+//  POST /api/v1/reportimage, /api/v1/reportvideo            media records
+//  GET  /api/v1/reportsubsection/<id>/images|videos/report/<id>
+//  PUT  /s3/<key>                                           S3 object upload, answers an ETag
+//  POST /s3                                                 S3 form upload as react-native-aws3 sends it, answers 201 with the XML PostResponse
+//Request bodies may be gzipped. A sync post with an Idempotency-Key seen before gets the first
+//answer again and is not applied twice.
+//
+//`latency` ms plus up to `jitter` ms delay every answer. With probability `loss` a request is
+//dropped, half of the time before it is applied (the request was lost) and half after (the
+//answer was lost).
+
+const http = require('http');
+const zlib = require('zlib');
+const crypto = require('crypto');
+const path = require('path');
+const fs = require('fs');
+
+const API = '/api/v1/';
+const FIXTURE = path.join(__dirname, '..', 'src', 'services', 'data.json');
+
+const readFixture = () => {
+    let data = JSON.parse(fs.readFileSync(FIXTURE, 'utf8'));
+    let reports = (data.reports && data.reports.data) || [];
+    return {
+        reports: reports.map((report) => Object.assign({report_id: report.id}, report)),
+        templates: data.templates || []
+    };
+};
+
+const createCoordinator = (options) => {
+    options = Object.assign({latency: 0, jitter: 0, loss: 0}, options);
+    let fixture = readFixture();
+
+    let reports = {};           //report_id -> report
+    let media = {};             //report_id -> {images: [], videos: []}
+    let objects = {};           //S3 key -> bytes
+    let answers = {};           //Idempotency-Key -> answer of the first request
+    let changes = [];           //report_id per version, the cursor is the version
+    let nextId = 100000;
+
+    let stats = {
+        requests: 0,
+        bytesIn: 0,
+        bytesOut: 0,
+        gzipBodies: 0,
+        operations: 0,
+        applied: {},            //operation_id -> times applied
+        replays: 0,
+        dropped: 0
+    };
+
+    fixture.reports.forEach((report) => {
+        reports[report.report_id] = report;
+    });
+
+    const getMedia = (report_id) => {
+        if (media[report_id] === undefined) {
+            media[report_id] = {images: [], videos: []};
+        }
+        return media[report_id];
+    };
+
+    const changed = (report_id) => {
+        changes.push(report_id);
+    };
+
+    const applyOperation = (operation) => {
+        stats.operations++;
+        stats.applied[operation.operation_id] = (stats.applied[operation.operation_id] || 0) + 1;
+
+        let answer = {operation_id: operation.operation_id, status: 1};
+        let report_id = operation.report_id;
+        if (operation.resource === 'report') {
+            report_id = (operation.primary_key !== undefined) ? operation.primary_key : operation.id;
+        }
+
+        if (operation.operation === 'INSERT') {
+            answer.id = nextId++;
+            if (operation.resource === 'report') {
+                report_id = answer.id;
+                reports[report_id] = Object.assign({}, operation.data, {id: answer.id, report_id: answer.id});
+            } else if (operation.resource === 'images' || operation.resource === 'videos') {
+                let record = Object.assign({}, operation.data, {id: answer.id});
+                if (operation.resource === 'images') {
+                    answer.original = record.original = 'http://media/' + answer.id + '.jpg';
+                } else {
+                    answer.src_url = record.src_url = 'http://media/' + answer.id + '.mp4';
+                }
+                getMedia(report_id)[operation.resource].push(record);
+            }
+        } else if (operation.operation === 'DELETE' && operation.resource === 'report') {
+            delete reports[report_id];
+        } else if (reports[report_id] !== undefined) {
+            if (operation.resource === 'report') {
+                reports[report_id] = Object.assign({}, reports[report_id], operation.data);
+            } else if (/_image$/.test(operation.resource)) {
+                answer.image_path = 'http://media/' + operation.resource + '_' + report_id + '.jpg';
+            }
+        }
+        changed(report_id);
+        return answer;
+    };
+
+    const getExport = (since) => {
+        if (since === null) {
+            return {reports: Object.keys(reports).map((id) => reports[id]), schema: {templates: fixture.templates}, cursor: "" + changes.length};
+        }
+        let version = parseInt(since, 10);
+        if (!(version >= 0 && version <= changes.length)) {
+            return null;
+        }
+        let ids = {};
+        changes.slice(version).forEach((id) => {
+            ids[id] = true;
+        });
+        let result = {delta: true, reports: [], deleted: {reports: []}, cursor: "" + changes.length};
+        Object.keys(ids).forEach((id) => {
+            if (reports[id] !== undefined) {
+                result.reports.push(reports[id]);
+            } else {
+                result.deleted.reports.push(isNaN(id) ? id : Number(id));
+            }
+        });
+        return result;
+    };
+
+    const readBody = (req) => new Promise((resolve, reject) => {
+        let chunks = [];
+        req.on('data', (chunk) => chunks.push(chunk));
+        req.on('error', reject);
+        req.on('end', () => {
+            let body = Buffer.concat(chunks);
+            stats.bytesIn += body.length;
+            if (req.headers['content-encoding'] === 'gzip') {
+                stats.gzipBodies++;
+                zlib.gunzip(body, (error, plain) => error ? reject(error) : resolve(plain));
+            } else {
+                resolve(body);
+            }
+        });
+    });
+
+    const parseJson = (body) => {
+        try {
+            return JSON.parse(body.toString('utf8') || 'null');
+        } catch (e) {
+            return undefined;
+        }
+    };
+
+    //status, headers, body (object as JSON, string or Buffer as is)
+    const route = (req, url, body) => {
+        let pathname = url.pathname;
+        let method = req.method;
+
+        if (method === 'GET' && pathname === API + 'reporttemplate/export') {
+            let result = getExport(url.searchParams.get('since'));
+            return (result === null) ? [410, {}, {message: 'cursor expired'}] : [200, {}, result];
+        }
+        if (method === 'POST' && pathname === API + 'coordinator/sync/data') {
+            let operations = parseJson(body);
+            if (!Array.isArray(operations)) {
+                return [422, {}, {message: 'operations expected'}];
+            }
+            let key = req.headers['idempotency-key'];
+            if (key && answers[key] !== undefined) {
+                stats.replays++;
+                return answers[key];
+            }
+            let answer = [200, {}, operations.map(applyOperation)];
+            if (key) {
+                answers[key] = answer;
+            }
+            return answer;
+        }
+        let match = /^\/api\/v1\/report(image|video)$/.exec(pathname);
+        if (method === 'POST' && match) {
+            let record = Object.assign({}, parseJson(body), {id: nextId++});
+            getMedia(record.report_id)[match[1] + 's'].push(record);
+            changed(record.report_id);
+            return [200, {}, {data: record}];
+        }
+        match = /^\/api\/v1\/reportsubsection\/([^\/]+)\/(images|videos)\/report\/([^\/]+)$/.exec(pathname);
+        if (method === 'GET' && match) {
+            let list = getMedia(match[3])[match[2]].filter((item) => "" + item.report_subsection_id === match[1]);
+            return [200, {}, {data: list}];
+        }
+        if (method === 'PUT' && pathname.indexOf('/s3/') === 0) {
+            objects[pathname.slice(4)] = body;
+            return [200, {ETag: '"' + crypto.createHash('md5').update(body).digest('hex') + '"'}, ''];
+        }
+        if (method === 'POST' && (pathname === '/s3' || pathname === '/s3/')) {
+            let keyMatch = /name="key"\r\n\r\n([^\r]*)/.exec(body.toString('latin1'));
+            let key = keyMatch ? keyMatch[1] : 'upload-' + nextId++;
+            objects[key] = body;
+            let location = 'http://' + req.headers.host + '/s3/' + key;
+            return [201, {'Content-Type': 'application/xml', Location: location},
+                '<?xml version="1.0" encoding="UTF-8"?>\n<PostResponse><Location>' + location +
+                '</Location><Bucket>mock</Bucket><Key>' + key + '</Key><ETag>"' +
+                crypto.createHash('md5').update(body).digest('hex') + '"</ETag></PostResponse>'];
+        }
+        if (method === 'GET' && pathname.indexOf('/s3/') === 0 && objects[pathname.slice(4)] !== undefined) {
+            return [200, {}, objects[pathname.slice(4)]];
+        }
+        return [404, {}, {message: 'not found'}];
+    };
+
+    const delay = () => options.latency + Math.random() * options.jitter;
+
+    const handle = (req, res) => {
+        stats.requests++;
+        let url = new URL(req.url, 'http://localhost');
+        let loss = Math.random() < options.loss ? (Math.random() < 0.5 ? 'request' : 'answer') : null;
+
+        readBody(req)
+            .then((body) => {
+                if (loss === 'request') {
+                    return null;
+                }
+                return route(req, url, body);
+            }, () => [400, {}, {message: 'unreadable body'}])
+            .then((answer) => {
+                setTimeout(() => {
+                    if (loss !== null) {
+                        stats.dropped++;
+                        req.socket.destroy();
+                        return;
+                    }
+                    let [status, headers, payload] = answer;
+                    let text = (Buffer.isBuffer(payload) || typeof payload === 'string') ? payload : JSON.stringify(payload);
+                    let type = (typeof payload === 'object' && !Buffer.isBuffer(payload)) ? {'Content-Type': 'application/json'} : {};
+                    stats.bytesOut += Buffer.byteLength(text);
+                    res.writeHead(status, Object.assign(type, headers));
+                    res.end(text);
+                }, delay());
+            });
+    };
+
+    let server = http.createServer(handle);
+
+    return {
+        stats: stats,
+        reports: reports,
+        //resolves the base url, port 0 picks a free one
+        listen: (port) => new Promise((resolve) => {
+            server.listen(port || 0, '127.0.0.1', () => {
+                resolve('http://127.0.0.1:' + server.address().port);
+            });
+        }),
+        close: () => new Promise((resolve) => server.close(() => resolve()))
+    };
+};
+
+module.exports = {
+    createCoordinator: createCoordinator
+};
+
+if (require.main === module) {
+    let args = process.argv.slice(2);
+    let options = {};
+    for (let i = 0; i < args.length; i += 2) {
+        options[args[i].replace(/^--/, '')] = Number(args[i + 1]);
+    }
+    let coordinator = createCoordinator(options);
+    coordinator.listen(options.port || 3000).then((url) => {
+        console.log('coordinator stand-in on ' + url + API + ', media on ' + url + '/s3');
+        //started with fork(), the parent gets the url and asks for the stats
+        if (process.send) {
+            process.on('message', (message) => {
+                if (message === 'stats') {
+                    process.send({stats: coordinator.stats});
+                }
+            });
+            process.send({url: url});
+        }
+    });
+}
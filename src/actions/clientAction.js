@@ -1,13 +1,9 @@
 import React, { Component } from 'react';
+import { CallAuthApi } from '../services/apiCall';
 import {
-    AsyncStorage
-} from 'react-native';
-import { CallApi } from '../services/apiCall';
-import {
-    SET_ALL_REPORTS,
-    SET_CLIENT,
-    SET_SELECTED_REPORT
+    SET_CLIENT
 } from './type';
+import { updateReportFields } from './entityAction';
 import  {
     updateLocalDB
 } from './updatedAppDataAction'
@@ -18,53 +14,20 @@ import _ from 'lodash'
 export const getClientInformation = (reportID) => {
     return (dispatch, getState) => {
 
-        let token = "";
-        let header1 = "";
-        return AsyncStorage.getItem('user').then((value) => {
-
-            if(value != null) {
-                let parsedValue = JSON.parse(value);
-                token = parsedValue.token;
-            }
-
-            header1 = "Bearer " + token
-
-        }).then(()=>{
-            return CallApi(Constant.baseurl+Constant.reportDel + reportID + "/" + Constant.client,'get',{},{"Authorization":header1})
-                .then((response)=> {
-                    return Promise.resolve(response);
-                })
-                .catch((error)=>{
-                    return Promise.reject(error);
-                })
-        })
+        return CallAuthApi(Constant.baseurl+Constant.reportDel + reportID + "/" + Constant.client,'get',{})
+            .then((response)=> {
+                return Promise.resolve(response);
+            })
+            .catch((error)=>{
+                return Promise.reject(error);
+            });
     };
 };
 
 
 export const updateClientInformation = (clientInfo,report_id) => {
     return (dispatch, getState) => {
-        let reports = _.cloneDeep(getState().appAllData.reports);
-        let updatedReport = _.find(reports,{report_id:report_id});
-        if(updatedReport !== undefined){
-            let index = reports.indexOf(updatedReport);
-            updatedReport["client"] = clientInfo;
-            reports[index] = updatedReport;
-
-            dispatch({
-                type: SET_ALL_REPORTS,
-                payload: reports,
-            });
-
-            let selectedReport = getState().report.selectedReport;
-            selectedReport.report = updatedReport;
-            dispatch({
-                type: SET_SELECTED_REPORT,
-                payload: selectedReport,
-            });
-
-            //dispatch(updateLocalDB());
-        }
+        dispatch(updateReportFields(report_id, {client: clientInfo}));
         return Promise.resolve(true);
     };
 };
@@ -73,30 +36,17 @@ export const updateClientInformation = (clientInfo,report_id) => {
 export const addClientInformation = (clientInfo) => {
     return (dispatch, getState) => {
 
-        let token = "";
-        let header1 = "";
-        return AsyncStorage.getItem('user').then((value) => {
-
-            if(value != null) {
-                let parsedValue = JSON.parse(value);
-                token = parsedValue.token;
-            }
+        return CallAuthApi(Constant.baseurl + Constant.client,'post',clientInfo)
+            .then((response)=> {
 
-            header1 = "Bearer " + token
-
-        }).then(()=>{
-            return CallApi(Constant.baseurl + Constant.client,'post',clientInfo,{"Authorization":header1})
-                .then((response)=> {
-
-                     dispatch(
-                        getClientInformation()
-                    );
-                    return Promise.resolve(response);
-                })
-                .catch((error)=>{
-                    return Promise.reject(error);
-                })
-        })
+                 dispatch(
+                    getClientInformation()
+                );
+                return Promise.resolve(response);
+            })
+            .catch((error)=>{
+                return Promise.reject(error);
+            });
     };
 };
 
@@ -1,45 +1,33 @@
 import React, { Component } from 'react';
-import {
-    AsyncStorage
-} from 'react-native';
-import { CallApi } from '../services/apiCall';
+import { CallAuthApi } from '../services/apiCall';
 import {
     SET_COMMENT,
     GET_COMMENT,
     SET_ALL_COMMENTS
 } from './type';
 import Constant from '../helper/constant'
+import {
+    setIn,
+    pushIn
+} from '../services/immutable';
 let _ = require('lodash');
 
 
 export const getComment = (subSectionID) => {
     return (dispatch, getState) => {
 
-        let token = "";
-        let header1 = "";
-        return AsyncStorage.getItem('user').then((value) => {
-
-            if(value != null) {
-                let parsedValue = JSON.parse(value);
-                token = parsedValue.token;
-            }
-
-            header1 = "Bearer " + token
-
-        }).then(()=>{
-            return CallApi(Constant.baseurl+Constant.comments+ subSectionID,'get',{},{"Authorization":header1})
-                .then((response)=> {
-
-                    dispatch({
-                        type: SET_COMMENT,
-                        payload: response.comments,
-                    });
-                    return Promise.resolve(response);
-                })
-                .catch((error)=>{
-                    return Promise.reject(error);
-                })
-        })
+        return CallAuthApi(Constant.baseurl+Constant.comments+ subSectionID,'get',{})
+            .then((response)=> {
+
+                dispatch({
+                    type: SET_COMMENT,
+                    payload: response.comments,
+                });
+                return Promise.resolve(response);
+            })
+            .catch((error)=>{
+                return Promise.reject(error);
+            });
     };
 };
 
@@ -47,12 +35,8 @@ export const getComment = (subSectionID) => {
 export const addComment = (comment,subsectionID) => {
     return (dispatch, getState) => {
         let key = 'subsection_' + subsectionID;
-        let comments = _.cloneDeep(getState().appAllData.comments);
-        if (comments.hasOwnProperty(key)) {
-            comments[key].push(comment)
-        } else {
-            comments[key] = [comment]
-        }
+        let comments = pushIn(getState().appAllData.comments, [key], comment);
+
         dispatch({
             type: SET_ALL_COMMENTS,
             payload: comments,
@@ -64,31 +48,18 @@ export const addComment = (comment,subsectionID) => {
 
 export const filterComment = (commentText,subSectionID) => {
     return (dispatch, getState) => {
-        let token = "";
-        let header1 = "";
-        return AsyncStorage.getItem('user').then((value) => {
-
-            if(value != null) {
-                let parsedValue = JSON.parse(value);
-                token = parsedValue.token;
-            }
-
-            header1 = "Bearer " + token
-
-        }).then(()=>{
-            return CallApi(Constant.baseurl+Constant.filterComment + commentText + "&subsectionId=" + subSectionID,'get',{},{"Authorization":header1})
-                .then((response)=> {
-                    dispatch({
-                        type: SET_COMMENT,
-                        payload: response.comments,
-                    });
-
-                    return Promise.resolve(response);
-                })
-                .catch((error)=>{
-                    return Promise.reject(error);
-                })
-        })
+        return CallAuthApi(Constant.baseurl+Constant.filterComment + commentText + "&subsectionId=" + subSectionID,'get',{})
+            .then((response)=> {
+                dispatch({
+                    type: SET_COMMENT,
+                    payload: response.comments,
+                });
+
+                return Promise.resolve(response);
+            })
+            .catch((error)=>{
+                return Promise.reject(error);
+            });
     };
 };
 
@@ -96,11 +67,8 @@ export const filterComment = (commentText,subSectionID) => {
 export const deleteComment = (commentID,subsectionID) => {
     return (dispatch, getState) => {
         let key = 'subsection_' + subsectionID;
-        let comments = _.cloneDeep(getState().appAllData.comments);
-        let filteredComment = comments[key];
-
-        _.remove(filteredComment,{id: commentID});
-        comments[key] = filteredComment;
+        let comments = getState().appAllData.comments;
+        comments = setIn(comments, [key], _.reject(comments[key], {id: commentID}));
 
         dispatch({
             type: SET_ALL_COMMENTS,
@@ -0,0 +1,59 @@
+import {
+    SET_ALL_REPORTS,
+    SET_SELECTED_REPORT,
+    SET_ENTITY_FIELDS
+} from './type';
+import { batch } from '../services/batch';
+
+//Applies `update` (report => report) to one entry of appAllData.reports, and to the selected
+//report when it is the same one. `update` copies only the path it changes, see services/immutable, and the other entries
+//of the array are shared with the previous state. The caller has already applied the same change
+//to the entity tables, so they are not rebuilt for the new report.
+export const commitReport = (report_id, update) => {
+    return batch((dispatch, getState) => {
+        let reports = getState().appAllData.reports;
+        let index = getState().entities.reportPosition[report_id];
+        if (reports[index] === undefined || reports[index].report_id !== report_id) {
+            index = reports.findIndex((item) => item.report_id === report_id);
+            if (index === -1) {
+                return undefined;
+            }
+        }
+
+        let report = update(reports[index]);
+        reports = reports.slice();
+        reports[index] = report;
+
+        dispatch({
+            type: SET_ALL_REPORTS,
+            payload: reports,
+            meta: {report_id: report_id},
+        });
+
+        let selectedReport = getState().report.selectedReport;
+        if (selectedReport.report && selectedReport.report.report_id === report_id) {
+            dispatch({
+                type: SET_SELECTED_REPORT,
+                payload: Object.assign({}, selectedReport, {report: report}),
+            });
+        }
+        return report;
+    });
+};
+
+//Dispatches a change to the entity tables and applies the same change to the report with
+//commitReport, subscribers are notified once for both
+export const commitEntityChange = (entityAction, report_id, update) => {
+    return batch((dispatch) => {
+        dispatch(entityAction);
+        return dispatch(commitReport(report_id, update));
+    });
+};
+
+//Sets top level fields of one report
+export const updateReportFields = (report_id, fields) => {
+    return commitEntityChange({
+        type: SET_ENTITY_FIELDS,
+        payload: {report_id: report_id, fields: fields},
+    }, report_id, (report) => Object.assign({}, report, fields));
+};
@@ -1,14 +1,232 @@
 import React, { Component } from 'react';
-import { CallApi } from '../services/apiCall';
+import RNFetchBlob from 'react-native-fetch-blob';
+import { CallAuthApi } from '../services/apiCall';
+import { getAuthHeader } from '../services/authSession';
+import {
+    schedule,
+    PRIORITY_BACKGROUND
+} from '../services/requestScheduler';
+import { createJsonStream } from '../services/jsonStream';
+import Constant from '../helper/constant';
 import {
     SET_ALL_REPORTS,
     SET_ALL_COMMENTS,
     SET_ALL_TEMPLATES,
     SET_APP_DATA_LOADER,
-    SET_NETWORK_STATE
+    SET_NETWORK_STATE,
+    SET_EXPORT_CURSOR,
+    SET_UPDATED_DATA
 } from './type';
+import {
+    loadSyncJournal,
+    getSyncQueue
+} from '../services/syncJournal';
+import { getQueueSize } from '../services/syncQueue';
+import {
+    loadIdMap,
+    clearIdMap,
+    resolveReportId,
+    resolveReport
+} from '../services/idMap';
+import { loadAppData } from '../services/appDataStorage';
+
+const exportUrl = Constant.baseurl + Constant.templateExport;
+
+//Replaces changed entries of `list` by `key` and drops deleted ones, entries not mentioned
+//(including reports only created on this device) are kept as they are. `getListKey` gives the
+//key an entry of `list` is known by on the server.
+const mergeById = (list, changed, deleted, key, getListKey = (item) => item[key]) => {
+    let result = (list || []).slice();
+    let indexById = {};
+    result.forEach((item, index) => {
+        indexById[getListKey(item)] = index;
+    });
+
+    (changed || []).forEach((item) => {
+        if (indexById.hasOwnProperty(item[key])) {
+            result[indexById[item[key]]] = item;
+        } else {
+            indexById[item[key]] = result.length;
+            result.push(item);
+        }
+    });
+
+    if (deleted && deleted.length !== 0) {
+        let deletedIds = {};
+        deleted.forEach((id) => {
+            deletedIds[id] = true;
+        });
+        result = result.filter((item) => !deletedIds[getListKey(item)]);
+    }
+    return result;
+};
+
+//The id table is needed as long as queued operations or reports in the store refer to local ids
+const pruneIdMap = (getState) => {
+    return Promise.all([loadSyncJournal(), loadIdMap()]).then(() => {
+        let isInUse = getQueueSize(getSyncQueue()) !== 0 ||
+            getState().appAllData.reports.some((report) => resolveReport(report) !== report);
+        if (!isInUse) {
+            return clearIdMap();
+        }
+    });
+};
+
+const setExportData = (dispatch, getState, response) => {
+    //reports created offline keep their local report_id in the store after the INSERT was
+    //acknowledged, the export knows them by the server id and replaces them
+    return loadIdMap().then(() => {
+        applyExportData(dispatch, getState, response);
+        return pruneIdMap(getState);
+    });
+};
+
+const applyExportData = (dispatch, getState, response) => {
+    let deleted = response.deleted || {};
+    let appAllData = getState().appAllData;
+    let templates = response.schema && response.schema.templates;
+
+    if (response.delta) {
+        dispatch({
+            type: SET_ALL_REPORTS,
+            payload: mergeById(appAllData.reports, response.reports, deleted.reports, 'report_id',
+                (report) => resolveReportId(report.report_id)),
+        });
+        if (response.comments) {
+            dispatch({
+                type: SET_ALL_COMMENTS,
+                payload: Object.assign({}, appAllData.comments, response.comments),
+            });
+        }
+        dispatch({
+            type: SET_ALL_TEMPLATES,
+            payload: mergeById(appAllData.templates, templates, deleted.templates, 'template_id'),
+        });
+    } else {
+        if(response.reports){
+            dispatch({
+                type: SET_ALL_REPORTS,
+                payload: response.reports,
+            });
+        }
+        if(response.comments){
+            dispatch({
+                type: SET_ALL_COMMENTS,
+                payload: response.comments,
+            });
+        }
+        if(templates){
+            dispatch({
+                type: SET_ALL_TEMPLATES,
+                payload: templates,
+            });
+        }
+    }
+
+    dispatch({
+        type: SET_EXPORT_CURSOR,
+        payload: response.cursor || null,
+    });
+};
+
+//Values of the export read by the streaming parser, reports are handed over one by one
+const EXPORT_SELECTORS = {
+    'reports[]': true,
+    'reports.data[]': true,
+    'comments': true,
+    'schema.templates': true,
+    'cursor': true
+};
+
+//Full export: the payload is downloaded to a temporary file and parsed while it is read back in
+//chunks, reports reach the store a page at a time so the dashboard can show the first page early
+const streamFullExport = (dispatch, getState) => {
+    let path = null;
+    let removeFile = () => {
+        if (path !== null) {
+            RNFetchBlob.fs.unlink(path).catch(() => {});
+        }
+    };
+
+    return getAuthHeader()
+        .then((header) => schedule(PRIORITY_BACKGROUND, () => RNFetchBlob.config({fileCache: true}).fetch('GET', exportUrl, header)))
+        .then((res) => {
+            path = res.path();
+            if (res.info().status !== 200) {
+                return Promise.reject(res.info());
+            }
+            return RNFetchBlob.fs.readStream(path, 'utf8', Constant.exportReadBuffer);
+        })
+        .then((stream) => new Promise((resolve, reject) => {
+            let reports = [];
+            let page = [];
+            let isFirstPage = true;
+            let response = {schema: {}};
+
+            let flushPage = () => {
+                if (page.length === 0 && !isFirstPage) {
+                    return;
+                }
+                reports = reports.concat(page);
+                page = [];
+                dispatch({
+                    type: SET_ALL_REPORTS,
+                    payload: reports,
+                });
+                if (isFirstPage) {
+                    isFirstPage = false;
+                    dispatch({
+                        type: SET_APP_DATA_LOADER,
+                        payload: true,
+                    });
+                }
+            };
+
+            let parser = createJsonStream(EXPORT_SELECTORS, (valuePath, value) => {
+                if (valuePath === 'reports[]' || valuePath === 'reports.data[]') {
+                    page.push(value);
+                    if (page.length >= Constant.exportPageSize) {
+                        flushPage();
+                    }
+                } else if (valuePath === 'schema.templates') {
+                    response.schema.templates = value;
+                } else {
+                    response[valuePath] = value;
+                }
+            });
+
+            stream.open();
+            stream.onData((chunk) => {
+                try {
+                    parser.write(chunk);
+                } catch (e) {
+                    reject(e);
+                }
+            });
+            stream.onError(reject);
+            stream.onEnd(() => {
+                parser.end();
+                flushPage();
+                response.reports = reports;
+                resolve(response);
+            });
+        }))
+        .then((response) => {
+            removeFile();
+            return setExportData(dispatch, getState, Object.assign({}, response, {reports: undefined}))
+                .then(() => response);
+        }, (error) => {
+            removeFile();
+            return Promise.reject(error);
+        });
+};
 
 //Get App response
+//With a cursor from the previous export only entities changed since then are requested:
+//  {delta: true, cursor, reports: [...], comments: {subsection_<id>: [...]}, schema: {templates: [...]},
+//   deleted: {reports: [report_id], templates: [template_id]}}
+//A full export is streamed when there is no cursor or the server rejects it (410 Gone), a
+//response without `delta` always replaces the local data.
 export const getAllData = () => {
     return (dispatch, getState) => {
         dispatch({
@@ -16,32 +234,30 @@ export const getAllData = () => {
             payload: false,
         });
 
-        let token = "Bearer " + getState().userlogin.token;
-        return CallApi("http://staging-api.inspectionadvisor.com/api/v1/reporttemplate/export" ,'get',{},
-            {"Authorization":token})
-            .then((response)=> {
-                if(response.reports){
-                    dispatch({
-                        type: SET_ALL_REPORTS,
-                        payload: response.reports,
-                    });
-                }
-                if(response.comments){
-                    dispatch({
-                        type: SET_ALL_COMMENTS,
-                        payload: response.comments,
-                    });
-                }
-                if(response.schema){
+        let cursor = getState().sync.exportCursor;
+        let request;
 
-                    if(response.schema.templates){
+        if (cursor) {
+            request = CallAuthApi(exportUrl + "?since=" + encodeURIComponent(cursor) ,'get',{},{},{cache: false, priority: PRIORITY_BACKGROUND})
+                .then((response)=> {
+                    return setExportData(dispatch, getState, response)
+                        .then(() => response);
+                }, (error)=>{
+                    if(error.response && error.response.status === 410){
                         dispatch({
-                            type: SET_ALL_TEMPLATES,
-                            payload: response.schema.templates,
+                            type: SET_EXPORT_CURSOR,
+                            payload: null,
                         });
+                        return streamFullExport(dispatch, getState);
                     }
-                }
+                    return Promise.reject(error);
+                });
+        } else {
+            request = streamFullExport(dispatch, getState);
+        }
 
+        return request
+            .then((response)=> {
                 dispatch({
                     type: SET_APP_DATA_LOADER,
                     payload: true,
@@ -59,6 +275,57 @@ export const getAllData = () => {
     };
 };
 
+//Puts the persisted appAllData back into the store, resolves true when it came from the old
+//single redux-persist value and still has to be written as shards. `rehydrated` resolves once
+//redux-persist has restored the other reducers, `sync` with the export cursor among them.
+export const restoreAppData = (rehydrated = Promise.resolve()) => {
+    return (dispatch, getState) => {
+        return loadAppData().then((data) => {
+            if (data === undefined) {
+                //a cursor without the data it was taken for would only fetch later changes,
+                //it is dropped after rehydration so that the persisted one does not come back
+                return rehydrated.then(() => {
+                    //data fetched meanwhile came with its own cursor
+                    if (getState().appAllData.reports.length === 0) {
+                        dispatch({
+                            type: SET_EXPORT_CURSOR,
+                            payload: null,
+                        });
+                    }
+                    return false;
+                });
+            }
+            //data fetched meanwhile is newer
+            if (getState().appAllData.reports.length === 0) {
+                dispatch({
+                    type: SET_ALL_REPORTS,
+                    payload: data.reports || [],
+                });
+                dispatch({
+                    type: SET_ALL_COMMENTS,
+                    payload: data.comments || {},
+                });
+                dispatch({
+                    type: SET_ALL_TEMPLATES,
+                    payload: data.templates || [],
+                });
+                dispatch({
+                    type: SET_APP_DATA_LOADER,
+                    payload: !!data.dataLoaded,
+                });
+            }
+            //queued operations of older versions, moved to the sync journal by the next sync
+            if (data.isLegacy && data.updatedData) {
+                dispatch({
+                    type: SET_UPDATED_DATA,
+                    payload: data.updatedData,
+                });
+            }
+            return !!data.isLegacy;
+        });
+    };
+};
+
 export const setNetworkState = (state) => {
     return (dispatch, getState) => {
         dispatch({
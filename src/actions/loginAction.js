@@ -1,7 +1,4 @@
 import React, { Component } from 'react';
-import {
-    AsyncStorage
-} from 'react-native';
 import { CallApi } from '../services/apiCall';
 import {
     APP_SET_USER_DATA,
@@ -11,6 +8,14 @@ import {
 } from './type';
 import Constant from '../helper/constant'
 import {getAllData} from './getAllDataAction';
+import {clearSyncJournal} from '../services/syncJournal';
+import {clearIdMap} from '../services/idMap';
+import {clearApiCache} from '../services/apiCache';
+import {
+    setSession,
+    clearSession,
+    setRefreshListener
+} from '../services/authSession';
 
 export const loginUser = (email, password) => {
     return (dispatch, getState) => {
@@ -25,7 +30,7 @@ export const loginUser = (email, password) => {
                     organization_id: response.data.user.organization_id,
                     profileimage:response.data.user.image_path,
                 };
-                AsyncStorage.setItem('user',JSON.stringify(user));
+                setSession(user);
                 return Promise.all([
                     dispatch({
                         type: APP_SET_USER_DATA,
@@ -57,10 +62,13 @@ export const passChanged = (text) => {
 
 export const setUserLogout = (isNetwork) => {
     return (dispatch, getState) => {
-        return AsyncStorage.removeItem('user', (err) => {
+        return clearSession().then(() => {
             dispatch({
                 type: USER_LOGOUT
             });
+            clearSyncJournal();
+            clearIdMap();
+            clearApiCache();
 
             dispatch({
                 type: SET_NETWORK_STATE,
@@ -69,4 +77,16 @@ export const setUserLogout = (isNetwork) => {
             return Promise.resolve(true);
         })
     };
-};
\ No newline at end of file
+};
+
+//Keeps userlogin in line with the session when an expired token is replaced
+export const startAuthSession = () => {
+    return (dispatch, getState) => {
+        setRefreshListener((data) => {
+            dispatch({
+                type: APP_SET_USER_DATA,
+                payload: data,
+            });
+        });
+    };
+};
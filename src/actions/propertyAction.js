@@ -1,13 +1,9 @@
 import React, { Component } from 'react';
+import { CallAuthApi } from '../services/apiCall';
 import {
-    AsyncStorage
-} from 'react-native';
-import { CallApi } from '../services/apiCall';
-import {
-    SET_PROPERTY,
-    SET_ALL_REPORTS,
-    SET_SELECTED_REPORT
+    SET_PROPERTY
 } from './type';
+import { updateReportFields } from './entityAction';
 import Constant from '../helper/constant'
 import {
     getReportList
@@ -21,61 +17,28 @@ import _ from 'lodash'
 export const getPropertyInformation = (reportID) => {
     return (dispatch, getState) => {
 
-        let token = "";
-        let header1 = "";
-        return AsyncStorage.getItem('user').then((value) => {
-
-            if(value != null) {
-                let parsedValue = JSON.parse(value);
-                token = parsedValue.token;
-            }
-
-            header1 = "Bearer " + token
-
-        }).then(()=>{
-            return CallApi(Constant.baseurl+Constant.reportDel + reportID + "/" + Constant.property,'get',{},{"Authorization":header1})
-                .then((response)=> {
-                    dispatch({
-                        type: SET_PROPERTY,
-                        payload: response.property,
-                    });
+        return CallAuthApi(Constant.baseurl+Constant.reportDel + reportID + "/" + Constant.property,'get',{})
+            .then((response)=> {
+                dispatch({
+                    type: SET_PROPERTY,
+                    payload: response.property,
+                });
 
-                    return Promise.resolve(response);
-                })
-                .catch((error)=>{
+                return Promise.resolve(response);
+            })
+            .catch((error)=>{
 
-                    return Promise.reject(error);
-                })
-        })
+                return Promise.reject(error);
+            });
     };
 };
 
 
 export const updatePropertyInformation = (propertyInfo,report_id) => {
-        return (dispatch, getState) => {
-            let reports = _.cloneDeep(getState().appAllData.reports);
-            let updatedReport = _.find(reports,{report_id:report_id});
-            if(updatedReport !== undefined){
-                let index = reports.indexOf(updatedReport);
-                updatedReport["property"] = propertyInfo;
-                reports[index] = updatedReport;
-
-                dispatch({
-                    type: SET_ALL_REPORTS,
-                    payload: reports,
-                });
-
-                let selectedReport = getState().report.selectedReport;
-                selectedReport.report = updatedReport;
-                dispatch({
-                    type: SET_SELECTED_REPORT,
-                    payload: selectedReport,
-                });
-
-                //dispatch(updateLocalDB());
-            }
-            return Promise.resolve(true);
-        };
+    return (dispatch, getState) => {
+        dispatch(updateReportFields(report_id, {property: propertyInfo}));
+        return Promise.resolve(true);
+    };
 };
 
 
@@ -83,31 +46,18 @@ export const updatePropertyInformation = (propertyInfo,report_id) => {
 export const addPropertyInformation = (propertyInfo) => {
     return (dispatch, getState) => {
 
-        let token = "";
-        let header1 = "";
-        return AsyncStorage.getItem('user').then((value) => {
-
-            if(value != null) {
-                let parsedValue = JSON.parse(value);
-                token = parsedValue.token;
-            }
-
-            header1 = "Bearer " + token
-
-        }).then(()=>{
-            return CallApi(Constant.baseurl+Constant.reportProperty,'post',propertyInfo,{"Authorization":header1})
-                .then((response)=> {
+        return CallAuthApi(Constant.baseurl+Constant.reportProperty,'post',propertyInfo)
+            .then((response)=> {
 
-                    dispatch(
-                        getReportList()
-                    );
+                dispatch(
+                    getReportList()
+                );
 
-                    return Promise.resolve(response);
-                })
-                .catch((error)=>{
+                return Promise.resolve(response);
+            })
+            .catch((error)=>{
 
-                    return Promise.reject(error);
-                })
-        })
+                return Promise.reject(error);
+            });
     };
 };
@@ -1,81 +1,54 @@
 import React, { Component } from 'react';
-import {
-    AsyncStorage
-} from 'react-native';
-import { CallApi } from '../services/apiCall';
+import { CallAuthApi } from '../services/apiCall';
 import {
     SET_REPORT,
     SET_SELECTED_REPORT,
-    SET_ALL_REPORTS
+    SET_ALL_REPORTS,
+    SET_ALL_TEMPLATES
 } from './type';
 import {
     getReportList
 } from './reportListAction'
 import Constant from '../helper/constant'
+import { resolveReport } from '../services/idMap';
+import { updateReportFields } from './entityAction';
+import { batch } from '../services/batch';
+import { getCompiledTemplate } from '../selectors/appDataSelectors';
+import {
+    loadReportBody,
+    loadTemplateBody
+} from '../services/appDataStorage';
 import _ from 'lodash';
 
 export const getReport = (reportID) => {
     return (dispatch, getState) => {
-        let token = "";
-        let header1 = "";
-        return AsyncStorage.getItem('user').then((value) => {
-
-            if(value !== null) {
-                let parsedValue = JSON.parse(value);
-                token = parsedValue.token;
-            }
-
-            header1 = "Bearer " + token
-
-        }).then(()=>{
-            return CallApi(Constant.baseurl+Constant.reportDel + reportID ,'get',{},{"Authorization":header1})
-                .then((response)=> {
-                    dispatch({
-                        type: SET_REPORT,
-                        payload: response.report,
-                    });
-
-                    return Promise.resolve(response);
-                })
-                .catch((error)=>{
-
-                    return Promise.reject(error);
-                })
-        })
+        return CallAuthApi(Constant.baseurl+Constant.reportDel + reportID ,'get',{})
+            .then((response)=> {
+                dispatch({
+                    type: SET_REPORT,
+                    payload: response.report,
+                });
+
+                return Promise.resolve(response);
+            })
+            .catch((error)=>{
+
+                return Promise.reject(error);
+            });
     };
 };
 
 
 export const updateReport = (report_id,data) => {
     return (dispatch, getState) => {
-
-        let reports = _.cloneDeep(getState().appAllData.reports);
-        let updatedReport = _.find(reports,{report_id:report_id});
-        if(updatedReport !== undefined){
-            let index = reports.indexOf(updatedReport);
-            updatedReport["inspection_date_time"] = data["inspection_date_time"];
-            reports[index] = updatedReport;
-
-            dispatch({
-                type: SET_ALL_REPORTS,
-                payload: reports,
-            });
-
-            let selectedReport = getState().report.selectedReport;
-            selectedReport.report = updatedReport;
-            dispatch({
-                type: SET_SELECTED_REPORT,
-                payload: selectedReport,
-            });
-        }
+        dispatch(updateReportFields(report_id, {inspection_date_time: data["inspection_date_time"]}));
         return Promise.resolve(true);
     };
 };
 
 export const deleteReport = (report_id) => {
     return (dispatch, getState) => {
-    let reports = _.cloneDeep(getState().appAllData.reports);
-     _.remove(reports,{report_id: report_id});
+        let reports = _.reject(getState().appAllData.reports, {report_id: report_id});
 
         dispatch({
             type: SET_ALL_REPORTS,
@@ -87,8 +60,7 @@ export const deleteReport = (report_id) => {
 
 export const addReport = (reportInfo) => {
     return (dispatch, getState) => {
-        let reports = _.cloneDeep(getState().appAllData.reports);
-        reports.push(reportInfo);
+        let reports = getState().appAllData.reports.concat([reportInfo]);
 
         dispatch({
             type: SET_ALL_REPORTS,
@@ -98,21 +70,81 @@ export const addReport = (reportInfo) => {
     };
 };
 
+//Reports and templates restored at startup are summaries until they are opened, see
+//services/appDataStorage. Their bodies replace the summaries in the store.
+const loadBodies = (dispatch, getState, report_id, template) => {
+    let report = _.find(getState().appAllData.reports, {report_id: report_id});
+
+    return Promise.all([
+        (report && report.isSummary) ? loadReportBody(report_id) : null,
+        (template && template.isSummary) ? loadTemplateBody(template.template_id) : null
+    ]).then(([reportBody, templateBody]) => {
+        dispatch(batch(() => {
+            let reports = getState().appAllData.reports;
+            let reportIndex = _.findIndex(reports, {report_id: report_id});
+            if (reportBody && reportIndex !== -1 && reports[reportIndex].isSummary) {
+                reports = reports.slice();
+                reports[reportIndex] = reportBody;
+                dispatch({
+                    type: SET_ALL_REPORTS,
+                    payload: reports,
+                });
+            }
+
+            let templates = getState().appAllData.templates;
+            let compiled = template && getCompiledTemplate(getState(), template.template_id);
+            let templateIndex = compiled ? compiled.position : -1;
+            if (templateBody && templateIndex !== -1 && templates[templateIndex].isSummary) {
+                templates = templates.slice();
+                templates[templateIndex] = templateBody;
+                dispatch({
+                    type: SET_ALL_TEMPLATES,
+                    payload: templates,
+                });
+            }
+        }));
+    }).catch((error) => {
+        console.log('report body unreadable', error);
+    });
+};
+
 export const setSelectedReport = (report_id, template_id) => {
     return (dispatch, getState) => {
-        let report = _.find(getState().appAllData.reports, {report_id: report_id});
-        let template = _.find(getState().appAllData.templates, {template_id: parseInt(template_id)});
-        if(template === undefined){
-            template = {};
-        }
-
-        dispatch({
-            type: SET_SELECTED_REPORT,
-            payload: {
-                report: report,
-                template: template
-            },
+        let compiled = getCompiledTemplate(getState(), parseInt(template_id));
+
+        return loadBodies(dispatch, getState, report_id, compiled && compiled.source).then(() => {
+            dispatch(batch(() => {
+                let reports = getState().appAllData.reports;
+                let index = getState().entities.reportPosition[report_id];
+                if (reports[index] === undefined || reports[index].report_id !== report_id) {
+                    index = _.findIndex(reports, {report_id: report_id});
+                }
+                let report = reports[index];
+                let loaded = getCompiledTemplate(getState(), parseInt(template_id));
+                let template = loaded ? loaded.source : {};
+
+                //pick up server ids assigned since the report was created offline
+                if(report !== undefined){
+                    let resolved = resolveReport(report);
+                    if(resolved !== report){
+                        report = resolved;
+                        reports = reports.slice();
+                        reports[index] = report;
+                        dispatch({
+                            type: SET_ALL_REPORTS,
+                            payload: reports,
+                        });
+                    }
+                }
+
+                dispatch({
+                    type: SET_SELECTED_REPORT,
+                    payload: {
+                        report: report,
+                        template: template
+                    },
+                });
+            }));
         });
     }
 };
-
@@ -1,115 +1,80 @@
 import React, { Component } from 'react';
-import {
-
-    AsyncStorage
-
-} from 'react-native';
-import { CallApi } from '../services/apiCall';
+import { CallAuthApi } from '../services/apiCall';
 import {
     SET_FORMDATA,
     GET_IMAGES,
     GET_VIDEOS,
-    SET_ALL_REPORTS,
-    SET_SELECTED_REPORT
+    SET_ENTITY_SUBSECTION,
+    SET_ENTITY_MEDIA
 } from './type';
 import Constant from '../helper/constant'
+import { commitEntityChange } from './entityAction';
+import {
+    setIn,
+    pushIn,
+    removeIn
+} from '../services/immutable';
 let _ = require('lodash');
 
+//inspectionForm keeps editing its image and video lists after saving them
+const copySubsection = (subsection) => {
+    let copy = Object.assign({}, subsection);
+    ['images', 'videos'].forEach((kind) => {
+        if (copy[kind] !== undefined) {
+            copy[kind] = copy[kind].map((media) => Object.assign({}, media));
+        }
+    });
+    return copy;
+};
 
-export const getReportData = (subsectionID,reportID) => {
-    return (dispatch, getState) => {
-
-        let token = "";
-        let header1 = "";
-        return AsyncStorage.getItem('user').then((value) => {
+//An empty `data` comes from the server as an array, subsections are keyed by name
+const withData = (report) => {
+    return (report.data && report.data.length === undefined) ? report : setIn(report, ['data'], {});
+};
 
-            if(value !== null) {
-                let parsedValue = JSON.parse(value);
-                token = parsedValue.token;
-            }
 
-            header1 = "Bearer " + token
+export const getReportData = (subsectionID,reportID) => {
+    return (dispatch, getState) => {
 
-        }).then(()=>{
-            return CallApi(Constant.baseurl+Constant.reportSubSection + subsectionID + "/formdata/" + Constant.reportDel + reportID,'get',{},{"Authorization":header1})
-                .then((response)=> {
+        return CallAuthApi(Constant.baseurl+Constant.reportSubSection + subsectionID + "/formdata/" + Constant.reportDel + reportID,'get',{})
+            .then((response)=> {
 
-                    dispatch({
-                        type: SET_FORMDATA,
-                        payload: response.agent,
-                    });
+                dispatch({
+                    type: SET_FORMDATA,
+                    payload: response.agent,
+                });
 
-                    return Promise.resolve(response);
-                })
-                .catch((error)=>{
-                    return Promise.reject(error);
-                })
-        })
+                return Promise.resolve(response);
+            })
+            .catch((error)=>{
+                return Promise.reject(error);
+            });
     };
 };
 
 export const addReportData = (formData) => {
     return (dispatch, getState) => {
 
-        let token = "";
-        let header1 = "";
-        return AsyncStorage.getItem('user').then((value) => {
-
-            if(value !== null) {
-                let parsedValue = JSON.parse(value);
-                token = parsedValue.token;
-            }
-
-            header1 = "Bearer " + token
-
-        }).then(()=>{
-            return CallApi(Constant.baseurl+Constant.reportFiledata,'post',formData,{"Authorization":header1})
-                .then((response)=> {
-                    return Promise.resolve(response);
-                })
-                .catch((error)=>{
-                    return Promise.reject(error);
-                })
-        })
+        return CallAuthApi(Constant.baseurl+Constant.reportFiledata,'post',formData,{},{compress: true})
+            .then((response)=> {
+                return Promise.resolve(response);
+            })
+            .catch((error)=>{
+                return Promise.reject(error);
+            });
     };
 };
 
 
 export const updateReportData = (formData,report_id) => {
     return (dispatch, getState) => {
+        let key = Object.keys(formData)[0];
+        let subsection = copySubsection(formData[key]);
 
-        let reports = _.cloneDeep(getState().appAllData.reports);
-        let updatedReport = _.find(reports,{report_id:report_id});
-        if(updatedReport !== undefined){
-            let index = reports.indexOf(updatedReport);
-
-            if((updatedReport.data).hasOwnProperty(Object.keys(formData)[0])){
-                updatedReport.data[Object.keys(formData)[0]] = Object.values(formData)[0];
-            }else{
-                if(updatedReport.data.length === 0 || updatedReport.data.length !== undefined){
-                    updatedReport.data = {};
-                    updatedReport.data[Object.keys(formData)[0]] = Object.values(formData)[0];
-                }else{
-                    updatedReport.data[Object.keys(formData)[0]] = Object.values(formData)[0];
-                }
-
-            }
-
-            reports[index] = updatedReport;
-
-            dispatch({
-                type: SET_ALL_REPORTS,
-                payload: reports,
-            });
-
-
-            let selectedReport = getState().report.selectedReport;
-            selectedReport.report = updatedReport;
-            dispatch({
-                type: SET_SELECTED_REPORT,
-                payload: selectedReport,
-            });
-        }
+        dispatch(commitEntityChange({
+            type: SET_ENTITY_SUBSECTION,
+            payload: {report_id: report_id, key: key, subsection: subsection},
+        }, report_id, (report) => setIn(withData(report), ['data', key], subsection)));
         return Promise.resolve(true);
     };
 };
@@ -119,26 +84,13 @@ export const updateReportData = (formData,report_id) => {
 export const addReportImages = (formData) => {
     return (dispatch, getState) => {
 
-        let token = "";
-        let header1 = "";
-        return AsyncStorage.getItem('user').then((value) => {
-
-            if(value !== null) {
-                let parsedValue = JSON.parse(value);
-                token = parsedValue.token;
-            }
-
-            header1 = "Bearer " + token
-
-        }).then(()=>{
-            return CallApi(Constant.mediaBaseUrl + Constant.reportImages, 'post',formData,{"Authorization":header1})
-                .then((response)=> {
-                    return Promise.resolve(response);
-                })
-                .catch((error)=>{
-                    return Promise.reject(error);
-                })
-        })
+        return CallAuthApi(Constant.mediaBaseUrl + Constant.reportImages, 'post',formData)
+            .then((response)=> {
+                return Promise.resolve(response);
+            })
+            .catch((error)=>{
+                return Promise.reject(error);
+            });
     };
 };
 
@@ -146,59 +98,31 @@ export const addReportImages = (formData) => {
 export const getReportImages = (subsecid, reportid) => {
     return (dispatch, getState) => {
 
-        let token = "";
-        let header1 = "";
-        return AsyncStorage.getItem('user').then((value) => {
+        return CallAuthApi(Constant.mediaBaseUrl + Constant.reportMediaSubSection + subsecid + "/images/report/" + reportid , 'get', {})
+            .then((response)=> {
 
-            if(value !== null) {
-                let parsedValue = JSON.parse(value);
-                token = parsedValue.token;
-            }
+                dispatch({
+                    type: GET_IMAGES,
+                    payload: response.images,
+                });
 
-            header1 = "Bearer " + token
-
-        }).then(()=>{
-            return CallApi(Constant.mediaBaseUrl + Constant.reportMediaSubSection + subsecid + "/images/report/" + reportid , 'get', {},{"Authorization":header1})
-                .then((response)=> {
-
-                    dispatch({
-                        type: GET_IMAGES,
-                        payload: response.images,
-                    });
-
-                    return Promise.resolve(response);
-                })
-                .catch((error)=>{
-                    return Promise.reject(error);
-                })
-        })
+                return Promise.resolve(response);
+            })
+            .catch((error)=>{
+                return Promise.reject(error);
+            });
     };
 };
 
 export const addReportVideo = (videoObj, report_id, ssid) => {
     return (dispatch, getState) => {
-        let reports = _.cloneDeep(getState().appAllData.reports);
-        let updatedReport = _.find(reports,{report_id:report_id});
-        if(updatedReport !== undefined){
-            let index = reports.indexOf(updatedReport);
-            let key = "subsection_" + ssid;
-            let data = updatedReport["data"];
-            data[key].videos.push(videoObj);
-            updatedReport["data"] = data;
-            reports[index] = updatedReport;
-
-            dispatch({
-                type: SET_ALL_REPORTS,
-                payload: reports,
-            });
+        let key = "subsection_" + ssid;
+        let media = Object.assign({}, videoObj);
 
-            let selectedReport = getState().report.selectedReport;
-            selectedReport.report = updatedReport;
-            dispatch({
-                type: SET_SELECTED_REPORT,
-                payload: selectedReport,
-            });
-        }
+        dispatch(commitEntityChange({
+            type: SET_ENTITY_MEDIA,
+            payload: {report_id: report_id, key: key, kind: 'videos', index: undefined, media: media},
+        }, report_id, (report) => pushIn(withData(report), ['data', key, 'videos'], media)));
         return Promise.resolve(true);
     };
 };
@@ -206,115 +130,55 @@ export const addReportVideo = (videoObj, report_id, ssid) => {
 export const getReportVideo = (subsecid, reportid) => {
     return (dispatch, getState) => {
 
-        let token = "";
-        let header1 = "";
-        return AsyncStorage.getItem('user').then((value) => {
-
-            if(value !== null) {
-                let parsedValue = JSON.parse(value);
-                token = parsedValue.token;
-            }
-
-            header1 = "Bearer " + token
+        return CallAuthApi(Constant.mediaBaseUrl + Constant.reportMediaSubSection + subsecid + "/videos/report/" + reportid , 'get', {})
+            .then((response)=> {
 
-        }).then(()=>{
-            return CallApi(Constant.mediaBaseUrl + Constant.reportMediaSubSection + subsecid + "/videos/report/" + reportid , 'get', {},{"Authorization":header1})
-                .then((response)=> {
+                dispatch({
+                    type: GET_VIDEOS,
+                    payload: response.videos,
+                });
 
-                    dispatch({
-                        type: GET_VIDEOS,
-                        payload: response.videos,
-                    });
-
-                    return Promise.resolve(response);
-                })
-                .catch((error)=>{
-                    return Promise.reject(error);
-                })
-        })
+                return Promise.resolve(response);
+            })
+            .catch((error)=>{
+                return Promise.reject(error);
+            });
     };
 };
 
 export const deleteReportVideo = (e, report_id, ssid) => {
     return (dispatch, getState) => {
-        let reports = _.cloneDeep(getState().appAllData.reports);
-        let updatedReport = _.find(reports,{report_id:report_id});
-        if(updatedReport !== undefined){
-            let index = reports.indexOf(updatedReport);
-            let key = "subsection_" + ssid;
-            let dataInfo = updatedReport["data"];
-            dataInfo[key].videos.splice(e, 1);
-            updatedReport["data"] = dataInfo;
-            reports[index] = updatedReport;
-
-            dispatch({
-                type: SET_ALL_REPORTS,
-                payload: reports,
-            });
+        let key = "subsection_" + ssid;
 
-            let selectedReport = getState().report.selectedReport;
-            selectedReport.report = updatedReport;
-            dispatch({
-                type: SET_SELECTED_REPORT,
-                payload: selectedReport,
-            });
-        }
+        dispatch(commitEntityChange({
+            type: SET_ENTITY_MEDIA,
+            payload: {report_id: report_id, key: key, kind: 'videos', index: e, media: undefined},
+        }, report_id, (report) => removeIn(report, ['data', key, 'videos'], e)));
         return Promise.resolve(true);
     };
 };
 
 export const deleteReportImage = (e, report_id, ssid) => {
     return (dispatch, getState) => {
-        let reports = _.cloneDeep(getState().appAllData.reports);
-        let updatedReport = _.find(reports,{report_id:report_id});
-        if(updatedReport !== undefined){
-            let index = reports.indexOf(updatedReport);
-            let key = "subsection_" + ssid;
-            let dataInfo = updatedReport["data"];
-            dataInfo[key].images.splice(e, 1);
-            updatedReport["data"] = dataInfo;
-            reports[index] = updatedReport;
-
-            dispatch({
-                type: SET_ALL_REPORTS,
-                payload: reports,
-            });
+        let key = "subsection_" + ssid;
 
-            let selectedReport = getState().report.selectedReport;
-            selectedReport.report = updatedReport;
-            dispatch({
-                type: SET_SELECTED_REPORT,
-                payload: selectedReport,
-            });
-        }
+        dispatch(commitEntityChange({
+            type: SET_ENTITY_MEDIA,
+            payload: {report_id: report_id, key: key, kind: 'images', index: e, media: undefined},
+        }, report_id, (report) => removeIn(report, ['data', key, 'images'], e)));
         return Promise.resolve(true);
     };
 };
 
 export const updateReportImage = (imgObj, report_id, ssid) => {
     return (dispatch, getState) => {
-        let reports = _.cloneDeep(getState().appAllData.reports);
-        let updatedReport = _.find(reports,{report_id:report_id});
-        if(updatedReport !== undefined){
-            let index = reports.indexOf(updatedReport);
-            let key = "subsection_" + ssid;
-            let data = updatedReport["data"];
-            data[key].images.push(imgObj);
-            updatedReport["data"] = data;
-            reports[index] = updatedReport;
-
-            dispatch({
-                type: SET_ALL_REPORTS,
-                payload: reports,
-            });
+        let key = "subsection_" + ssid;
+        let media = Object.assign({}, imgObj);
 
-            let selectedReport = getState().report.selectedReport;
-            selectedReport.report = updatedReport;
-            dispatch({
-                type: SET_SELECTED_REPORT,
-                payload: selectedReport,
-            });
-        }
+        dispatch(commitEntityChange({
+            type: SET_ENTITY_MEDIA,
+            payload: {report_id: report_id, key: key, kind: 'images', index: undefined, media: media},
+        }, report_id, (report) => pushIn(withData(report), ['data', key, 'images'], media)));
         return Promise.resolve(true);
     };
 };
@@ -322,29 +186,13 @@ export const updateReportImage = (imgObj, report_id, ssid) => {
 
 export const updateReportVideoUrl = (e, obj, report_id, ssid) => {
     return (dispatch, getState) => {
-        debugger;
-        let reports = _.cloneDeep(getState().appAllData.reports);
-        let updatedReport = _.find(reports,{report_id:report_id});
-        if(updatedReport !== undefined){
-            let index = reports.indexOf(updatedReport);
-            let key = "subsection_" + ssid;
-            let dataInfo = updatedReport["data"];
-            dataInfo[key].videos[e] = obj;
-            updatedReport["data"] = dataInfo;
-            reports[index] = updatedReport;
-
-            dispatch({
-                type: SET_ALL_REPORTS,
-                payload: reports,
-            });
+        let key = "subsection_" + ssid;
+        let media = Object.assign({}, obj);
 
-            let selectedReport = getState().report.selectedReport;
-            selectedReport.report = updatedReport;
-            dispatch({
-                type: SET_SELECTED_REPORT,
-                payload: selectedReport,
-            });
-        }
+        dispatch(commitEntityChange({
+            type: SET_ENTITY_MEDIA,
+            payload: {report_id: report_id, key: key, kind: 'videos', index: e, media: media},
+        }, report_id, (report) => setIn(withData(report), ['data', key, 'videos', e], media)));
         return Promise.resolve(true);
     };
 };
\ No newline at end of file
@@ -1,10 +1,5 @@
 import React, { Component } from 'react';
-import {
-
-    AsyncStorage
-
-} from 'react-native';
-import { CallApi } from '../services/apiCall';
+import { CallAuthApi } from '../services/apiCall';
 import {
     SET_REPORT_LIST,
     DELETE_REPORT
@@ -15,41 +10,25 @@ var _ = require('lodash');
 export const getReportList = () => {
     return (dispatch, getState) => {
 
-        let token = "";
-        let header1 = "";
-        return AsyncStorage.getItem('user').then((value) => {
-
-            if(value != null) {
-                let parsedValue = JSON.parse(value);
-                token = parsedValue.token;
-            }
-
-            header1 = "Bearer " + token
-
-        }).then(()=>{
-            return CallApi(Constant.baseurl+Constant.reports,'get',{},{"Authorization":header1})
-                .then((response)=> {
-                    dispatch({
-                        type: SET_REPORT_LIST,
-                        payload: response.reports.data,
-                    });
+        return CallAuthApi(Constant.baseurl+Constant.reports,'get',{})
+            .then((response)=> {
+                dispatch({
+                    type: SET_REPORT_LIST,
+                    payload: response.reports.data,
+                });
 
-                    return Promise.resolve(response);
+                return Promise.resolve(response);
 
-                })
-                .catch((error)=>{
-                    return Promise.reject(error);
-                })
-        })
+            })
+            .catch((error)=>{
+                return Promise.reject(error);
+            });
     };
 };
 
 
 export const deleteReportList = (reportid) => {
   return (dispatch, getState) => {
-    let token = "";
-    let header1 = "";
-
       let reportList = _.cloneDeep(getState().reportList.reports);
       let deleteReport = _.find(reportList, {id:reportid});
       let newReportList = _.without(reportList, deleteReport);
@@ -60,25 +39,14 @@ export const deleteReportList = (reportid) => {
       });
 
 
-    return AsyncStorage.getItem('user').then((value) => {
-
-        if(value != null) {
-            let parsedValue = JSON.parse(value);
-            token = parsedValue.token;
-        }
-
-        header1 = "Bearer " + token
-
-    }).then(()=>{
-        return CallApi(Constant.baseurl+Constant.reportDel+reportid,'delete',{},{"Authorization":header1})
-            .then((response)=> {
-                return Promise.resolve(response);
+    return CallAuthApi(Constant.baseurl+Constant.reportDel+reportid,'delete',{})
+        .then((response)=> {
+            return Promise.resolve(response);
 
-            })
-            .catch((error)=>{
-                return Promise.reject(error);
-            })
-    })
+        })
+        .catch((error)=>{
+            return Promise.reject(error);
+        });
 
 
   };
@@ -1,33 +1,15 @@
-import { CallApi } from '../services/apiCall';
-import {
-
-    AsyncStorage
-
-} from 'react-native';
+import { CallAuthApi } from '../services/apiCall';
 import Constant from '../helper/constant'
 
 export const sendReportData = (reportFormData,reportID) => {
     return (dispatch, getState) => {
 
-        let token = "";
-        let header1 = "";
-        return AsyncStorage.getItem('user').then((value) => {
-
-            if(value != null) {
-                let parsedValue = JSON.parse(value);
-                token = parsedValue.token;
-            }
-
-            header1 = "Bearer " + token
-
-        }).then(()=>{
-            return CallApi(Constant.baseurl+Constant.generateReport + "send/" + reportID,'post',reportFormData,{"Authorization":header1})
-                .then((response)=> {
-                    return Promise.resolve(response);
-                })
-                .catch((error)=>{
-                    return Promise.reject(error);
-                })
-        })
+        return CallAuthApi(Constant.baseurl+Constant.generateReport + "send/" + reportID,'post',reportFormData,{},{compress: true})
+            .then((response)=> {
+                return Promise.resolve(response);
+            })
+            .catch((error)=>{
+                return Promise.reject(error);
+            });
     };
 };
\ No newline at end of file
@@ -42,6 +42,11 @@ export const SET_ALL_REPORTS = "SET_ALL_REPORTS";
 export const SET_ALL_COMMENTS = "SET_ALL_COMMENTS";
 export const SET_ALL_TEMPLATES = "SET_ALL_TEMPLATES";
 
+//Normalized entities
+export const SET_ENTITY_FIELDS = "SET_ENTITY_FIELDS";
+export const SET_ENTITY_SUBSECTION = "SET_ENTITY_SUBSECTION";
+export const SET_ENTITY_MEDIA = "SET_ENTITY_MEDIA";
+
 export const ADD_REPORT = "ADD_REPORT";
 
 export const SET_SELECTED_REPORT = "SET_SELECTED_REPORT";
@@ -50,6 +55,8 @@ export const SET_APP_DATA_LOADER = "SET_APP_DATA_LOADER";
 
 export const SET_UPDATED_DATA = "SET_UPDATED_DATA";
 
+export const SET_EXPORT_CURSOR = "SET_EXPORT_CURSOR";
+
 export const SET_NETWORK_STATE = "SET_NETWORK_STATE";
 
 export const USER_LOGOUT = "USER_LOGOUT";
\ No newline at end of file
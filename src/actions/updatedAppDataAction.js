@@ -1,240 +1,281 @@
-import {Platform, ToastAndroid} from 'react-native';
 import {
     SET_UPDATED_DATA,
     SET_ALL_REPORTS
 } from './type';
 import _ from 'lodash';
-import { CallApi } from '../services/apiCall';
+import {
+    CallAuthApi,
+    getSentBytes
+} from '../services/apiCall';
+import { getSyncBatches } from '../services/syncScheduler';
+import {
+    compactOperation,
+    findOperation,
+    removeOperation,
+    getQueueSize,
+    toArray,
+    enqueue
+} from '../services/syncQueue';
+import {
+    loadSyncJournal,
+    getSyncQueue,
+    setSyncQueue
+} from '../services/syncJournal';
+import { wakeSyncEngine } from '../services/syncEngine';
+import { batch as batchDispatch } from '../services/batch';
+import { PRIORITY_BACKGROUND } from '../services/requestScheduler';
+import {
+    classifyError,
+    getIdempotencyKey,
+    ERROR_NETWORK,
+    ERROR_SERVER,
+    ERROR_CONFLICT
+} from '../services/retryPolicy';
+import {
+    recordEnqueue,
+    recordBatch,
+    recordFailure,
+    recordDrained
+} from '../services/syncTelemetry';
+import {
+    loadIdMap,
+    getMappingKey,
+    getMapping,
+    setMapping,
+    resolveOperation
+} from '../services/idMap';
+import Constant from '../helper/constant';
+
+const IMAGE_OWNERS = {
+    property_image: 'property',
+    client_image: 'client',
+    agent_image: 'agent'
+};
 
-export const setUpdatedData = (updatedData) => {
-    return (dispatch, getState) => {
+//operation_id -> true for operations posted and not yet answered
+let inFlight = {};
+//operation_id -> true for operations a rejecting batch carried, they wait for the next retry
+let heldBack = {};
+//batches that got no answer, a server error or a 409, the server may have committed them or
+//still be working on them. They are resent on retry as they were, with the same idempotency
+//key: {operations, payload, key}
+let retryBatches = [];
+let sendingBatches = 0;
+
+//operation_id -> true for operations compaction must leave alone, the server may have them
+const getSentOperations = () => {
+    let sent = Object.assign({}, inFlight);
+    retryBatches.forEach((entry) => {
+        entry.operations.forEach((operation) => {
+            sent[operation.operation_id] = true;
+        });
+    });
+    return sent;
+};
 
-        let updatedDataArr = getState().appAllData.updatedData;
-        let updatedReport = _.find(updatedDataArr,{primary_key:updatedData.primary_key});
+//The queue lives in the sync journal, not in the persisted store. Operations left in
+//appAllData.updatedData by older versions are moved over to the journal once.
+const loadQueue = (dispatch, getState) => {
+    return Promise.all([loadSyncJournal(), loadIdMap()]).then(() => {
+        let legacy = getState().appAllData.updatedData;
+        let operations = Array.isArray(legacy) ? legacy : (legacy && legacy.operations) ? toArray(legacy) : [];
+
+        if (operations.length !== 0) {
+            let result = getSyncQueue();
+            operations.forEach((operation) => {
+                if (findOperation(result, operation.operation_id) === undefined) {
+                    result = enqueue(result, operation);
+                }
+            });
+            setSyncQueue(result);
 
-        if(updatedReport !== undefined) {
-            let index = updatedDataArr.indexOf(updatedReport);
-            updatedDataArr[index] = updatedData;
-        }else{
-            updatedDataArr.push(updatedData);
+            dispatch({
+                type: SET_UPDATED_DATA,
+                payload: [],
+            });
         }
-
-        dispatch({
-            type: SET_UPDATED_DATA,
-            payload: updatedDataArr,
-        });
-
-        return Promise.resolve(true);
-    }
+        return getSyncQueue();
+    });
 };
 
-export const postUpdatedData = () => {
+export const setUpdatedData = (updatedData) => {
     return (dispatch, getState) => {
-        let updatedDataArr = getState().appAllData.updatedData;
+        return loadQueue(dispatch, getState).then((queue) => {
+            //a local entity whose INSERT was acknowledged is on the server even if the store still says otherwise
+            if (updatedData.isLocal && getMapping(getMappingKey(updatedData)) !== undefined) {
+                updatedData = Object.assign({}, updatedData);
+                delete updatedData.isLocal;
+            }
+            setSyncQueue(compactOperation(queue, updatedData, getSentOperations()));
+            recordEnqueue(getQueueSize(getSyncQueue()));
+            wakeSyncEngine();
 
-        if(Platform.OS === "ios"){
-            //alert('Back');
-        }
-        else{
-            ToastAndroid.show('Background', ToastAndroid.SHORT);
-        }
+            return Promise.resolve(true);
+        });
+    }
+};
 
-        if(updatedDataArr.length !== 0) {
-            debugger;
-            let token = "Bearer " + getState().userlogin.token;
-            return CallApi("http://staging-api.inspectionadvisor.com/api/v1/coordinator/sync/data", 'post',
-                updatedDataArr[0], {"Authorization":token})
-                .then((response)=> {
-                    debugger;
-                    dispatch(updateLocalDB(response.data[0]));
-                    return Promise.resolve(true);
-                })
-                .catch((error)=>{
-                    return Promise.reject(error);
-                });
+//Cached reads a batch may change, those of the reports its operations belong to
+const getBatchReports = (payload) => {
+    let paths = {};
+    payload.forEach((operation) => {
+        let report_id = operation.report_id;
+        if (operation.resource === 'report') {
+            report_id = (operation.primary_key !== undefined) ? operation.primary_key : operation.id;
         }
-        else {
-            return Promise.resolve(false);
+        if (report_id !== undefined) {
+            paths[Constant.reportDel + report_id] = true;
         }
-    }
+    });
+    return Object.keys(paths);
 };
 
-export const updateLocalDB = (res) => {
-    return (dispatch, getState) => {
-
-        let updatedDataArr = getState().appAllData.updatedData;
-        let reports = getState().appAllData.reports;
-        let filteredData = _.find(updatedDataArr, {operation_id: res.operation_id});
-
-        debugger;
-        if(filteredData !== undefined) {
-
-            if(Platform.OS === "ios"){
-                alert(filteredData.resource+" "+filteredData.operation);
-            }
-            else{
-                ToastAndroid.show(filteredData.resource+" "+filteredData.operation, ToastAndroid.SHORT);
-            }
-            if (filteredData.resource === 'report' && filteredData.operation === 'INSERT') {
-                let report = _.find(reports, {report_id: filteredData.primary_key});
-
-                if (report !== undefined) {
-                    let index = reports.indexOf(report);
-                    reports[index].report_id = res.id;
-                    delete reports[index]["isLocal"];
-                }
+const createSyncBatch = (operations) => {
+    return {
+        operations: operations,
+        payload: operations.map(resolveOperation),
+        key: getIdempotencyKey('sync', operations.map((operation) => operation.operation_id))
+    };
+};
 
-                dispatch({
-                    type: SET_ALL_REPORTS,
-                    payload: reports
+//Resolves true when the server acknowledged every operation of the batch. Operations it did not
+//acknowledge, and those of a batch it rejected, are held back until the engine retries. A batch
+//without an answer, or answered with a server error or 409, is kept as it is for the retry.
+const postSyncBatch = (dispatch, entry) => {
+    let batch = entry.operations;
+    let payload = entry.payload;
+    batch.forEach((operation) => {
+        inFlight[operation.operation_id] = true;
+    });
+    sendingBatches++;
+
+    let start = Date.now();
+
+    const finish = () => {
+        sendingBatches--;
+        batch.forEach((operation) => {
+            delete inFlight[operation.operation_id];
+        });
+    };
+
+    return CallAuthApi(Constant.baseurl + Constant.syncData, 'post', payload, {},
+        {
+            priority: PRIORITY_BACKGROUND,
+            compress: true,
+            rawError: true,
+            invalidate: getBatchReports(payload),
+            idempotencyKey: entry.key
+        })
+        .then((response)=> {
+            let stored = [];
+            dispatch(batchDispatch((dispatch) => {
+                (response.data || []).forEach((res) => {
+                    stored.push(dispatch(updateLocalDB(res)));
                 });
-
-                //update report_id of other object in queue related to that report
-                let dataToBeUpdate = _.filter(updatedDataArr, {report_id: filteredData.primary_key});
-                for (i = 0; i < dataToBeUpdate.length; i++) {
-                    let dataArr = getState().appAllData.updatedData;
-                    let dataObject = _.find(dataArr, {primary_key: dataToBeUpdate[i].primary_key});
-
-                    if (dataObject !== undefined) {
-                        let index = dataArr.indexOf(dataObject);
-                        dataArr[index].report_id = res.id;
+            }));
+
+            //the operations stay in flight until their id mappings are stored
+            return Promise.all(stored).then(() => {
+                finish();
+
+                //acknowledged operations (status 1) have left the queue
+                let queue = getSyncQueue();
+                let acknowledged = [];
+                batch.forEach((operation) => {
+                    if (findOperation(queue, operation.operation_id) === undefined) {
+                        acknowledged.push(operation);
+                    } else {
+                        heldBack[operation.operation_id] = true;
                     }
-
-                    dispatch({
-                        type: SET_UPDATED_DATA,
-                        payload: dataArr,
-                    });
-                }
-            }
-            else if (filteredData.resource === 'property' && filteredData.operation === 'INSERT') {
-                let property = _.find(reports, {report_id: filteredData.report_id});
-
-                let index = reports.indexOf(property);
-                reports[index].property.id = res.id;
-                delete reports[index].property.isLocal;
-
-                dispatch({
-                    type: SET_ALL_REPORTS,
-                    payload: reports,
-                });
-            }
-            else if (filteredData.resource === 'agent' && filteredData.operation === 'INSERT') {
-                let agent = _.find(reports, {report_id: filteredData.report_id});
-
-                let index = reports.indexOf(agent);
-                reports[index].agent.id = res.id;
-                delete reports[index].agent.isLocal;
-
-                dispatch({
-                    type: SET_ALL_REPORTS,
-                    payload: reports,
                 });
-            }
-            else if (filteredData.resource === 'client' && filteredData.operation === 'INSERT') {
-                let client = _.find(reports, {report_id: filteredData.report_id});
-
-                let index = reports.indexOf(client);
-                reports[index].client.id = res.id;
-                delete reports[index].client.isLocal;
-
-                dispatch({
-                    type: SET_ALL_REPORTS,
-                    payload: reports,
+                recordBatch(acknowledged, getSentBytes(response), Date.now() - start);
+                return acknowledged.length === batch.length;
+            });
+        })
+        .catch((error)=>{
+            finish();
+            let errorClass = classifyError(error);
+            recordFailure(batch, errorClass);
+
+            if (errorClass === ERROR_NETWORK || errorClass === ERROR_SERVER || errorClass === ERROR_CONFLICT) {
+                retryBatches.push(entry);
+            } else {
+                batch.forEach((operation) => {
+                    heldBack[operation.operation_id] = true;
                 });
             }
-            else if (filteredData.resource === 'property_image' && filteredData.operation === 'UPDATE') {
-                let property = _.find(reports, {report_id: filteredData.report_id});
-
-                let index = reports.indexOf(property);
-                reports[index].property.image_path = res.image_path;
+            return Promise.reject(error);
+        });
+};
 
-                dispatch({
-                    type: SET_ALL_REPORTS,
-                    payload: reports,
-                });
+//Starts a batch for every free slot and resolves with their promises, see services/syncEngine.
+//`isRetry` resends the batches that got no answer first and releases the operations held back.
+export const postUpdatedData = (isRetry) => {
+    return (dispatch, getState) => {
+        return loadQueue(dispatch, getState).then((queue) => {
+            let slots = Constant.syncMaxInFlight - sendingBatches;
+            let batches = [];
+            if (isRetry) {
+                heldBack = {};
+                while (batches.length < slots && retryBatches.length !== 0) {
+                    let entry = retryBatches.shift();
+                    //a batch the queue no longer fully holds was answered meanwhile, its rest is batched again
+                    if (entry.operations.every((operation) => findOperation(queue, operation.operation_id) !== undefined)) {
+                        batches.push(entry);
+                    }
+                }
             }
-            else if (filteredData.resource === 'client_image' && filteredData.operation === 'UPDATE') {
-                let property = _.find(reports, {report_id: filteredData.report_id});
 
-                let index = reports.indexOf(property);
-                reports[index].client.image_path = res.image_path;
-
-                dispatch({
-                    type: SET_ALL_REPORTS,
-                    payload: reports,
+            let excluded = Object.assign({}, heldBack, getSentOperations());
+            batches.forEach((entry) => {
+                entry.operations.forEach((operation) => {
+                    excluded[operation.operation_id] = true;
                 });
+            });
+            if (slots > batches.length) {
+                batches = batches.concat(getSyncBatches(queue, excluded, slots - batches.length).map(createSyncBatch));
             }
-            else if (filteredData.resource === 'agent_image' && filteredData.operation === 'UPDATE') {
-                let property = _.find(reports, {report_id: filteredData.report_id});
-
-                let index = reports.indexOf(property);
-                reports[index].agent.image_path = res.image_path;
 
-                dispatch({
-                    type: SET_ALL_REPORTS,
-                    payload: reports,
-                });
+            if (batches.length === 0 && sendingBatches === 0 && getQueueSize(queue) === 0) {
+                recordDrained(0);
             }
-            else if (filteredData.resource === 'formData' && filteredData.operation === 'INSERT') {
-                let updatedReport = _.find(reports, {report_id: filteredData.report_id});
-
-                if(updatedReport !== undefined) {
-                    let index = reports.indexOf(updatedReport);
-                    let key = "subsection_" + filteredData.data.report_subsection_id;
-                    let dataInfo = updatedReport["data"];
+            //independent reports are posted concurrently, a slow or failing one does not hold back the others
+            return batches.map((entry) => postSyncBatch(dispatch, entry));
+        });
+    }
+};
 
-                    dataInfo[key].filedata.id = res.id;
-                    delete dataInfo[key].filedata.isLocal;
+export const updateLocalDB = (res) => {
+    return (dispatch, getState) => {
 
-                    updatedReport["data"] = dataInfo;
-                    reports[index] = updatedReport;
+        let reports = getState().appAllData.reports;
+        let filteredData = findOperation(getSyncQueue(), res.operation_id);
+        let stored = Promise.resolve();
 
-                    dispatch({
-                        type: SET_ALL_REPORTS,
-                        payload: reports,
-                    });
+        if(filteredData !== undefined) {
+            if (filteredData.operation === 'INSERT') {
+                //children and local copies pick the server id up from the table when they are sent or read
+                let mapping = {id: res.id};
+                if (filteredData.resource === 'images') {
+                    mapping.original = res.original;
+                } else if (filteredData.resource === 'videos') {
+                    mapping.src_url = res.src_url;
                 }
+                stored = setMapping(getMappingKey(filteredData), mapping);
             }
-            else if (filteredData.resource === 'images' && filteredData.operation === 'INSERT') {
-                let updatedReport = _.find(reports, {report_id: filteredData.report_id});
-                /*delete reports[index].client.isLocal;*/
-
-                if(updatedReport !== undefined) {
-                    let index = reports.indexOf(updatedReport);
-                    let key = "subsection_" + filteredData.report_subsection_id;
-                    let dataInfo = updatedReport["data"];
-
-                    let imageData = _.find(dataInfo[key].images, {id: filteredData.primary_key});
-                    let imageIndex = dataInfo[key].images.indexOf(imageData);
-
-                    dataInfo[key].images[imageIndex].original = res.original;
-                    dataInfo[key].images[imageIndex].id = res.id;
-                    delete dataInfo[key].images[imageIndex].isLocal;
-                    updatedReport["data"] = dataInfo;
-                    reports[index] = updatedReport;
-
-                    dispatch({
-                        type: SET_ALL_REPORTS,
-                        payload: reports,
-                    });
+            else if (IMAGE_OWNERS.hasOwnProperty(filteredData.resource) && filteredData.operation === 'UPDATE') {
+                //the report may still carry the local id or already the server one
+                let index = _.findIndex(reports, {report_id: filteredData.report_id});
+                if (index === -1) {
+                    index = _.findIndex(reports, {report_id: resolveOperation(filteredData).report_id});
                 }
-            }
-            else if (filteredData.resource === 'videos' && filteredData.operation === 'INSERT') {
-                let updatedReport = _.find(reports, {report_id: filteredData.report_id});
-
-                if(updatedReport !== undefined) {
-                    let index = reports.indexOf(updatedReport);
-                    let key = "subsection_" + filteredData.report_subsection_id;
-                    let dataInfo = updatedReport["data"];
 
-                    let videosData = _.find(dataInfo[key].videos, {id: filteredData.primary_key});
-                    let videoIndex = dataInfo[key].videos.indexOf(videosData);
-
-                    dataInfo[key].videos[videoIndex].src_url = res.src_url;
-                    dataInfo[key].videos[videoIndex].id = res.id;
-                    delete dataInfo[key].videos[videoIndex].isLocal;
-                    updatedReport["data"] = dataInfo;
-                    reports[index] = updatedReport;
+                if (index !== -1) {
+                    let owner = IMAGE_OWNERS[filteredData.resource];
+                    let report = Object.assign({}, reports[index]);
+                    report[owner] = Object.assign({}, report[owner], {image_path: res.image_path});
+                    reports = reports.slice();
+                    reports[index] = report;
 
                     dispatch({
                         type: SET_ALL_REPORTS,
@@ -243,16 +284,16 @@ export const updateLocalDB = (res) => {
                 }
             }
 
+            //an INSERT leaves the journal only once its mapping is stored, a crash in between
+            //must not leave its children with the local id
             if(res.status === 1){
-                _.remove(updatedDataArr, {operation_id: res.operation_id});
-
-                dispatch({
-                    type: SET_UPDATED_DATA,
-                    payload: updatedDataArr
+                stored = stored.then(() => {
+                    setSyncQueue(removeOperation(getSyncQueue(), res.operation_id));
                 });
             }
-
-
         }
+        return stored.catch((error) => {
+            console.log('id mapping not stored', error);
+        });
     }
 };
\ No newline at end of file
@@ -16,8 +16,12 @@ module.exports = {
     OS : Platform.OS === 'ios',
 
     //API CONSTANT
+    //point baseurl and mediaHost at a local server to run the app against it
     baseurl:'http://staging-api.inspectionadvisor.com/api/v1/',
+    mediaHost:null,     //S3 compatible host for uploads, null for s3.amazonaws.com
     signin:'signin',
+    syncData:'coordinator/sync/data',
+    templateExport:'reporttemplate/export',
     reports:'report',
     reportDel:'report/',
     reportTemplate:'reporttemplate',
@@ -32,6 +36,40 @@ module.exports = {
     reportProperty:'reportproperty',
     reportFiledata:'reportfiledata',
 
+    //SYNC
+    syncBatchSize: 25,
+    syncBatchBytes: 256 * 1024,
+    syncMaxInFlight: 4,
+    syncRetryBase: 2000,
+    syncRetryMax: 5 * 60 * 1000,
+    syncJournalMaxRecords: 500,
+    syncTelemetryWindow: 15 * 60 * 1000,
+
+    //RETRY
+    requestRetries: 2,
+    requestRetryBase: 500,
+    requestRetryMax: 4000,
+
+    //EXPORT
+    exportPageSize: 50,
+    exportReadBuffer: 64 * 1024,
+
+    //PERSISTENCE
+    persistWriteDelay: 1000,
+    persistMaxDirty: 50,
+
+    //API CACHE
+    apiCacheTtl: 60 * 1000,
+    apiCacheMaxEntries: 200,
+
+    //REQUEST SCHEDULER
+    requestLimits: {interactive: 4, background: 2, transfer: 1},
+    requestYieldMax: 5000,
+
+    //REQUEST COMPRESSION
+    compressMinBytes: 1024,
+    compressChunkSize: 32 * 1024,
+
     mediaBaseUrl : 'https://staging-app.inspectionadvisor.com/api/v1/',
     reportImages : 'reportimage',
     reportVideos : 'reportvideo',
@@ -0,0 +1,66 @@
+import {
+    SET_ALL_REPORTS,
+    SET_ALL_COMMENTS,
+    SET_ALL_TEMPLATES,
+    SET_ENTITY_FIELDS,
+    SET_ENTITY_SUBSECTION,
+    SET_ENTITY_MEDIA
+} from "../actions/type"
+import {
+    createEntities,
+    normalizeReports,
+    normalizeComments,
+    setReportFields,
+    setSubsection,
+    setMedia
+} from '../services/entityStore'
+import { compileTemplates } from '../services/templateIndex'
+
+//Derived from appAllData, it is not persisted and is rebuilt from the SET_ALL_* actions of
+//restoreAppData on startup
+export default (state = createEntities(), action) => {
+    switch (action.type) {
+
+        case SET_ALL_REPORTS: {
+            //the entities of `meta.report_id` already describe the report it carries
+            if (action.meta && action.meta.report_id !== undefined) {
+                let report_id = action.meta.report_id;
+                let report = action.payload[state.reportPosition[report_id]];
+                if (report !== undefined && report.report_id === report_id) {
+                    let sources = Object.assign({}, state.sources);
+                    sources[report_id] = report;
+                    return {
+                        ...state,
+                        sources: sources,
+                    };
+                }
+            }
+            return normalizeReports(state, action.payload);
+        }
+        case SET_ALL_COMMENTS: {
+            return normalizeComments(state, action.payload);
+        }
+        case SET_ALL_TEMPLATES: {
+            return {
+                ...state,
+                templates: compileTemplates(state.templates, action.payload),
+            };
+        }
+        case SET_ENTITY_FIELDS: {
+            let payload = action.payload;
+            return setReportFields(state, payload.report_id, payload.fields);
+        }
+        case SET_ENTITY_SUBSECTION: {
+            let payload = action.payload;
+            return setSubsection(state, payload.report_id, payload.key, payload.subsection);
+        }
+        case SET_ENTITY_MEDIA: {
+            let payload = action.payload;
+            return setMedia(state, payload.report_id, payload.key, payload.kind, payload.index, payload.media);
+        }
+
+        default:
+            return state;
+
+    }
+}
@@ -14,6 +14,8 @@ import ReportTemplateReducer from './reportTemplateReducer';
 import CommentReducer from './commentReducer';
 import TouchIdReducer from './touchidReducer';
 import AppDataReducer from './getAllDataReducer';
+import SyncReducer from './syncReducer';
+import EntitiesReducer from './entitiesReducer';
 import { USER_LOGOUT } from "../actions/type"
 
 const AppReducer = combineReducers({
@@ -33,7 +35,9 @@ const AppReducer = combineReducers({
     agentInfo:AgentReducer,
     commentList:CommentReducer,
     touchId:TouchIdReducer,
-    appAllData:AppDataReducer
+    appAllData:AppDataReducer,
+    sync:SyncReducer,
+    entities:EntitiesReducer
 });
 
 const rootReducer = (state, action) => {
@@ -0,0 +1,21 @@
+import { SET_EXPORT_CURSOR } from "../actions/type"
+const INITIAL_STATE = {
+    exportCursor : null,
+}
+
+export default (state = INITIAL_STATE, action) => {
+    switch (action.type) {
+
+        case SET_EXPORT_CURSOR: {
+            return {
+                ...state,
+                exportCursor: action.payload,
+
+            };
+        }
+
+        default:
+            return state;
+
+    }
+}
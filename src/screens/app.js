@@ -6,14 +6,30 @@ import {
 } from 'react-native';
 import { Provider } from 'react-redux';
 import {persistStore, autoRehydrate} from 'redux-persist'
-import { createStore,applyMiddleware } from 'redux';
+import { createStore,applyMiddleware,compose } from 'redux';
 import thunk from 'redux-thunk';
 import AppReducer from '../reducers';
 import AppWithNavigationState from './navigator';
+import { restoreAppData } from '../actions/getAllDataAction';
+import { startAuthSession } from '../actions/loginAction';
+import { startAppDataStorage } from '../services/appDataStorage';
+import { batchedSubscribe } from '../services/batch';
+import Constant from '../helper/constant';
 
 export default class App extends React.Component {
-    store = createStore(AppReducer,applyMiddleware(thunk),autoRehydrate());
-    persisstore = persistStore(this.store, {blacklist: ['nav'], storage: AsyncStorage});
+    store = createStore(AppReducer,compose(autoRehydrate(),applyMiddleware(thunk),batchedSubscribe));
+    rehydrated = new Promise((resolve) => {
+        this.persisstore = persistStore(this.store, {blacklist: ['nav', 'entities', 'appAllData'], storage: AsyncStorage, debounce: Constant.persistWriteDelay}, resolve);
+    });
+
+    //appAllData is persisted per report and template by services/appDataStorage
+    componentWillMount() {
+        this.store.dispatch(startAuthSession());
+        this.store.dispatch(restoreAppData(this.rehydrated))
+            .then((isLegacy) => {
+                startAppDataStorage(this.store, isLegacy);
+            });
+    }
 
     render() {
         return (
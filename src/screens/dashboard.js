@@ -8,7 +8,6 @@ import {
     TouchableHighlight,
     NetInfo
 } from 'react-native';
-import BackgroundTimer from 'react-native-background-timer';
 import Const from '../helper/constant';
 import DashboardComponent from './component/dashboard/dashboardComponent'
 import FontSize from '../helper/fontsize';
@@ -19,6 +18,10 @@ import {
     setNetworkState
 } from "../actions/getAllDataAction"
 import {postUpdatedData} from '../actions/updatedAppDataAction';
+import {
+    startSyncEngine,
+    stopSyncEngine
+} from '../services/syncEngine';
 import SplashScreen from "react-native-splash-screen";
 const {height, width} = Const;
 const aspectRatio = height/width;
@@ -54,42 +57,11 @@ class Dashboard extends Component {
         console.log('Did mount.........');
 
         const dispatchConnected = isConnected => {
-            console.log('Dashboard did mount');
-            if(Const.OS){
-                console.log('Dashboard did mount ios');
-                BackgroundTimer.runBackgroundTimer(() => {
-                    console.log('Dashboard did mount ios background...');
-                    if(isConnected) {
-                        console.log('Dashboard did mount ios background connected');
-                        this.props.postUpdatedData()
-                            .then((resp) => {
-                                if(resp) {
-                                    console.log('data available');
-                                } else {
-                                    console.log('data not available');
-                                }
-                            })
-                    }
-                }, 5000);
-            }
-            else{
-                const intervalId = BackgroundTimer.setInterval(() => {
-                    console.log('Android - Running....');
-                    if(isConnected) {
-                        this.props.postUpdatedData()
-                            .then((resp) => {
-                                if(resp) {
-                                    console.log('data available');
-                                } else {
-                                    console.log('data not available');
-                                }
-                            })
-                    }
-                }, 5000);
-            }
             this.props.setNetworkState(isConnected)
         };
 
+        startSyncEngine((isRetry) => this.props.postUpdatedData(isRetry));
+
         NetInfo.isConnected.fetch().then().done(() => {
             NetInfo.isConnected.addEventListener('connectionChange', dispatchConnected);
         });
@@ -99,6 +71,10 @@ class Dashboard extends Component {
         });
     }
 
+    componentWillUnmount() {
+        stopSyncEngine();
+    }
+
     onPress = (selected) => {
         if(selected === "INSPECTION"){
             this.props.navigation.navigate('ReportList');
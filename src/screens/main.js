@@ -9,6 +9,7 @@ import Authentication from './authentication';
 import Loader from '../helper/loader';
 import Dashboard from './dashboard';
 import { connect } from 'react-redux';
+import { getSession } from '../services/authSession';
 let logging = false;
 
 let pageName = "login";
@@ -35,7 +36,7 @@ class Main extends Component {
 
     componentWillMount(){
         SplashScreen.hide();
-        AsyncStorage.getItem('user').then((value) => {
+        getSession().then((value) => {
             if(value) {
                 pageName = "Dashboard";
             }else{
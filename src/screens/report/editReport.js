@@ -16,6 +16,7 @@ import Header from '../../screens/component/header';
 import Modal from 'react-native-modal';
 import SendReportModal from '../component/sendReportModal';
 import { connect } from 'react-redux';
+import { getSelectedTemplate } from '../../selectors/appDataSelectors';
 
 let sectionDetail = [{"Information":[{"name":"Property Information"},
     {"name":"Client Information"},{"name":"Agent Information"},{"name":"Inspection Report Options"},
@@ -42,8 +43,8 @@ class ReportSection extends Component{
     }
 
     componentDidMount(){
-        if(this.props.selectedReport.template.sections){
-            let sections = this.props.selectedReport.template.sections;
+        if(this.props.template && this.props.template.source.sections){
+            let sections = this.props.template.sectionList;
             sectionDetail.push({Inspection: sections});
             this.setState({
                 sectionDetail: sectionDetail
@@ -52,8 +53,8 @@ class ReportSection extends Component{
     }
 
     componentWillReceiveProps(nextProps) {
-        if(nextProps.selectedReport.template.sections){
-            let sections = nextProps.selectedReport.template.sections;
+        if(nextProps.template && nextProps.template.source.sections){
+            let sections = nextProps.template.sectionList;
             sectionDetail.push({Inspection: sections});
             this.setState({
                 sectionDetail: sectionDetail
@@ -211,6 +212,7 @@ class ReportSection extends Component{
 const mapStateToProps = state => {
     return {
         selectedReport: state.report.selectedReport,
+        template: getSelectedTemplate(state),
         report_limit: state.userlogin.userdata.organization_setting.report_limit || "",
         email: state.userlogin.userdata.email || "",
     };
@@ -28,7 +28,7 @@ import {
     setUpdatedData
 } from '../../../actions/updatedAppDataAction';
 import { getImage } from '../../../services/getImageVideoCall';
-import { RNS3 } from 'react-native-aws3';
+import { putMedia } from '../../../services/mediaTransfer';
 let views = null;
 let agentInfo = {};
 let searchAgent = [];
@@ -104,11 +104,9 @@ class AgentInformation extends Component{
             this.state.selected = value
         }
         if(this.state.agent){
-            let agent = this.state.agent;
-            agent[key] = value;
-            this.setState({
-                agent: agent
-            });
+            this.setState((state) => ({
+                agent: Object.assign({}, state.agent, {[key]: value})
+            }));
             agentInfo[key] = value;
         }else{
             agentInfo[key] = value;
@@ -135,14 +133,13 @@ class AgentInformation extends Component{
                 successActionStatus: 201
             };
 
-            RNS3.put(file, options)
+            putMedia(file, options, (e) => console.log(e.loaded / e.total))
                 .then(response => {
                     if (response.status !== 201)
                         throw new Error("Failed to upload image to S3");
                     agentInfo['image_path'] = response.body.postResponse.location;
                     this.onSave()
-                })
-                .progress((e) => console.log(e.loaded / e.total));
+                });
         }
         else{
             Alert.alert('Select Image')
@@ -256,7 +253,7 @@ class AgentInformation extends Component{
             });
             this.setState({image:Const.URIIMG});
             agentInfo['image_path'] = Const.URIIMG.uri;
-            this.state.agent.image_path = Const.URIIMG.uri;
+            this.setState((state) => ({agent: Object.assign({}, state.agent, {image_path: Const.URIIMG.uri})}));
 
             imageObj = {
                 resource: 'agent_image',
@@ -280,7 +277,7 @@ class AgentInformation extends Component{
             });
             agentInfo['image_path'] = '';
             if(this.state.agent !== null) {
-                this.state.agent.image_path = '';
+                this.setState((state) => ({agent: Object.assign({}, state.agent, {image_path: ''})}));
             }
         }else{
             this.setState({
@@ -491,7 +488,6 @@ class AgentInformation extends Component{
 const mapStateToProps = state => {
     return {
         selectedReport: state.report.selectedReport.report,
-        updatedDataArr: state.appAllData.updatedData,
         networkState: state.appAllData.isNetwork
     };
 };
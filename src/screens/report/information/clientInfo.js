@@ -14,7 +14,7 @@ import TextInputInfo from '../../component/textInputInfo';
 import DropDown from '../../component/infoDropDown';
 import ImageUpload from '../../component/imageUpload/imageUploadComponent';
 import Header from '../../component/header';
-import { RNS3 } from 'react-native-aws3';
+import { putMedia } from '../../../services/mediaTransfer';
 import { connect } from 'react-redux';
 import {
     addClientInformation,
@@ -109,11 +109,9 @@ class ClientInformation extends Component{
             this.state.selected = value
         }
         if(this.state.client){
-            let client = this.state.client;
-            client[key] = value;
-            this.setState({
-                client: client
-            });
+            this.setState((state) => ({
+                client: Object.assign({}, state.client, {[key]: value})
+            }));
             clientInfo[key] = value;
         }else{
             clientInfo[key] = value;
@@ -141,14 +139,13 @@ class ClientInformation extends Component{
                 successActionStatus: 201
             };
 
-            RNS3.put(file, options)
+            putMedia(file, options, (e) => console.log(e.loaded / e.total))
                 .then(response => {
                     if (response.status !== 201)
                         throw new Error("Failed to upload image to S3");
                     clientInfo['image_path'] = response.body.postResponse.location;
                     this.onSave()
-                })
-                .progress((e) => console.log(e.loaded / e.total));
+                });
         }
         else{
             Alert.alert('Select Image')
@@ -265,7 +262,7 @@ class ClientInformation extends Component{
             });
             clientInfo['image_path'] = Const.URIIMG.uri;
             this.setState({image:Const.URIIMG});
-            this.state.client.image_path = Const.URIIMG.uri;
+            this.setState((state) => ({client: Object.assign({}, state.client, {image_path: Const.URIIMG.uri})}));
 
             imageObj = {
                 resource: 'client_image',
@@ -285,7 +282,7 @@ class ClientInformation extends Component{
     onImageDeleted = () => {
         clientInfo['image_path'] = '';
         if(this.state.client !== null) {
-            this.state.client.image_path ="";
+            this.setState((state) => ({client: Object.assign({}, state.client, {image_path: ''})}));
         }
         this.setState({
             image: require('../../../assets/lane.jpeg')
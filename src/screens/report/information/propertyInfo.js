@@ -23,7 +23,7 @@ import {
     setUpdatedData
 } from '../../../actions/updatedAppDataAction';
 import { getImage } from '../../../services/getImageVideoCall';
-import { RNS3 } from 'react-native-aws3';
+import { putMedia } from '../../../services/mediaTransfer';
 let views = null;
 let propertyInfo = {};
 let imageObj = {};
@@ -108,14 +108,13 @@ class PropertyInformation extends Component{
                 successActionStatus: 201
             };
 
-            RNS3.put(file, options)
+            putMedia(file, options, (e) => console.log(e.loaded / e.total))
                 .then(response => {
                     if (response.status !== 201)
                         throw new Error("Failed to upload image to S3");
                     propertyInfo['image_path'] = response.body.postResponse.location;
                     this.onSave()
-                })
-                .progress((e) => console.log(e.loaded / e.total));
+                });
         }
         else{
             Alert.alert('Select Image')
@@ -138,11 +137,9 @@ class PropertyInformation extends Component{
             this.state.selected = value
         }
         if(this.state.property){
-            let property = this.state.property;
-            property[key] = value;
-            this.setState({
-                property: property
-            });
+            this.setState((state) => ({
+                property: Object.assign({}, state.property, {[key]: value})
+            }));
             propertyInfo[key] = value;
         }else{
             propertyInfo[key] = value;
@@ -250,7 +247,7 @@ class PropertyInformation extends Component{
             });
             propertyInfo['image_path'] = Const.URIIMG.uri;
             this.setState({image:Const.URIIMG});
-            this.state.property.image_path = Const.URIIMG.uri;
+            this.setState((state) => ({property: Object.assign({}, state.property, {image_path: Const.URIIMG.uri})}));
 
             imageObj = {
                 resource: 'property_image',
@@ -270,7 +267,7 @@ class PropertyInformation extends Component{
     onImageDeleted = () => {
         propertyInfo['image_path'] = '';
         if(this.state.property !== null) {
-            this.state.property.image_path ="";
+            this.setState((state) => ({property: Object.assign({}, state.property, {image_path: ''})}));
         }
         this.setState({
             image: require('../../../assets/lane.jpeg')
@@ -56,10 +56,19 @@ import {
 import {
     setUpdatedData
 } from '../../actions/updatedAppDataAction';
+import {
+    makeSelectSubsectionComments,
+    makeSelectSubsectionData,
+    getSelectedTemplate
+} from '../../selectors/appDataSelectors';
+import { getCompiledElements } from '../../services/templateIndex';
 import MultipleImageUpload from '../../screens/component/imageUpload/multipleImageUpload';
 import MultipleVideoUpload from '../../screens/component/videoUpload/multipleVideoUpload';
 import { getImage, getVideo } from '../../services/getImageVideoCall';
-import { RNS3 } from 'react-native-aws3';
+import {
+    putMedia,
+    downloadMedia
+} from '../../services/mediaTransfer';
 import TextEditor from '../../screens/component/textEditor'
 
 let views = null;
@@ -119,25 +128,25 @@ class InspectionForm extends Component {
     }
 
     componentDidMount() {
-        let sections = _.find(this.props.selectedReport.template.sections, {section_id:this.props.navigation.state.params.sectionId});
-        let subSection = _.find(sections.subsections, {subsection_id:this.props.navigation.state.params.subsectionID});
-        let key ='subsection_' + this.props.navigation.state.params.subsectionID;
+        let elements = getCompiledElements(this.props.template, this.props.navigation.state.params.subsectionID);
+        let subsectionData = this.props.subsectionData;
 
         // key exist in data
-        if(this.props.selectedReport.report.data[key]){
+        if(subsectionData){
+            //the store shares these arrays between states, the screen edits its own copies
             this.setState({
-                elements: subSection.form.form_elements,
-                formdataid: this.props.selectedReport.report.data[key].filedata.id,
-                formdata: this.props.selectedReport.report.data[key].filedata.form_data,
-                commentData: this.props.selectedReport.report.data[key].filedata.comments,
-                image: this.props.selectedReport.report.data[key].images,
-                video: this.props.selectedReport.report.data[key].videos
+                elements: elements,
+                formdataid: subsectionData.filedata.id,
+                formdata: subsectionData.filedata.form_data,
+                commentData: subsectionData.filedata.comments,
+                image: (subsectionData.images || []).slice(),
+                video: (subsectionData.videos || []).slice()
             });
-            form_data = this.props.selectedReport.report.data[key].filedata.form_data;
+            form_data = subsectionData.filedata.form_data;
         } else //key do not exist in data
         {
             this.setState({
-                elements: subSection.form.form_elements,
+                elements: elements,
                 formdataid: null,
                 formdata: [],
                 commentData: "",
@@ -174,10 +183,8 @@ class InspectionForm extends Component {
             isSearchComment:true
         });
 
-        let key ='subsection_' + this.props.navigation.state.params.subsectionID;
-
-        if(this.props.comments.hasOwnProperty(key) && this.props.comments[key].length > 0){
-            let newDataSource = ds.cloneWithRows(this.props.comments[key]);
+        if(this.props.comments.length > 0){
+            let newDataSource = ds.cloneWithRows(this.props.comments);
             this.setState({
                 dataSource:newDataSource,
                 isCommentData: true,
@@ -195,12 +202,9 @@ class InspectionForm extends Component {
 
         this.setState({searchComment:commentText});
 
-        let key ='subsection_' + this.props.navigation.state.params.subsectionID;
-        console.log(this.props.comments[key]);
-
         let tempArr = [];
 
-        this.props.comments[key].map((obj) => {
+        this.props.comments.map((obj) => {
             if(obj.comment.includes(commentText)){
                 tempArr.push(obj);
             }
@@ -254,10 +258,8 @@ class InspectionForm extends Component {
     deleteComments = (commentId) => {
         this.props.deleteComment(commentId,this.props.navigation.state.params.subsectionID)
             .then((res) => {
-                let key ='subsection_' + this.props.navigation.state.params.subsectionID;
-
-                if(this.props.comments.hasOwnProperty(key) && this.props.comments[key].length > 0){
-                    let newDataSource = ds.cloneWithRows(this.props.comments[key]);
+                if(this.props.comments.length > 0){
+                    let newDataSource = ds.cloneWithRows(this.props.comments);
                     this.setState({
                         dataSource:newDataSource,
                         isCommentData: true,
@@ -607,6 +609,7 @@ class InspectionForm extends Component {
                         this.props.navigation.state.params.subsectionID)
                         .then((response) => {
                             let array = this.state.image;
+                            let isLocal = (array[e] !== undefined) && array[e].isLocal;
                             array.splice(e, 1);
                             this.setState({image: array });
 
@@ -614,6 +617,7 @@ class InspectionForm extends Component {
                             let obj = {
                                 resource: 'images',
                                 id:id,
+                                isLocal:isLocal,
                                 report_id: this.props.selectedReport.report.report_id,
                                 subsection_id: this.props.navigation.state.params.subsectionID,
                                 operation: 'DELETE',
@@ -661,7 +665,13 @@ class InspectionForm extends Component {
                 successActionStatus: 201
             };
 
-            RNS3.put(file, options)
+            putMedia(file, options, (e) => {
+                this.setState({progress:e.loaded / e.total});
+                if(e.loaded / e.total === 1 ){
+                    this.setState({progress:0, textSms:'Media uploading...! '});
+                };
+                console.log(e.loaded / e.total);
+            })
                 .then(response => {
                     if (response.status !== 201)
                         throw new Error("Failed to upload image to S3");
@@ -675,13 +685,6 @@ class InspectionForm extends Component {
                     this.imageSent(response.body.postResponse.location, response.body.postResponse.key);
 
                     console.log('response from aws s3 img:', response.body);
-                })
-                .progress((e) => {
-                    this.setState({progress:e.loaded / e.total});
-                    if(e.loaded / e.total === 1 ){
-                        this.setState({progress:0, textSms:'Media uploading...! '});
-                    };
-                    console.log(e.loaded / e.total);
                 });
         }
         else{
@@ -768,7 +771,13 @@ class InspectionForm extends Component {
             successActionStatus: 201
         };
 
-        RNS3.put(file, options)
+        putMedia(file, options, (e) => {
+            this.setState({progress:e.loaded / e.total});
+            if(e.loaded / e.total === 1 ){
+                this.setState({progress:0});
+            };
+            console.log(e.loaded / e.total);
+        })
             .then(response => {
                 if (response.status !== 201)
                     throw new Error("Failed to upload image to S3");
@@ -776,13 +785,6 @@ class InspectionForm extends Component {
                 this.updateSelectedImage(imgID, response.body.postResponse.location);
 
                 console.log('response from aws s3 img:', response.body);
-            })
-            .progress((e) => {
-                this.setState({progress:e.loaded / e.total});
-                if(e.loaded / e.total === 1 ){
-                    this.setState({progress:0});
-                };
-                console.log(e.loaded / e.total);
             });
     };
 
@@ -959,14 +961,11 @@ class InspectionForm extends Component {
             const progressDivider = 5;
             let rand = Math.floor(1000000000000 + Math.random() * 9000000000000);
             const downloadDest = `${dirs}/videos/inspectionVideo${rand}.mp4`;
-            const ret = RNFS.downloadFile({
+            downloadMedia({
                 //fromUrl: this.state.video[e].src_url,
                 fromUrl: "https://in4staging.s3.amazonaws.com/orgId%2F020d8290-ecd5-49c6-84ee-9fdfd7af2f7a%2Finspections%2FreportId%2F139%2Fsection%2F134%2Fsubsection%2F1030%2FRoof+Style%2FRoof+Style6593778072246.mp4",
                 toFile: downloadDest, begin, progress, background, progressDivider
-            });
-            let jobId = ret.jobId;
-
-            ret.promise.then(res => {
+            }).then(res => {
                 console.log('download then:::');
 
 
@@ -1004,6 +1003,7 @@ class InspectionForm extends Component {
                         this.props.navigation.state.params.subsectionID)
                         .then((response) => {
                             let array = this.state.video;
+                            let isLocal = (array[e] !== undefined) && array[e].isLocal;
                             array.splice(e, 1);
                             this.setState({video: array });
 
@@ -1011,6 +1011,7 @@ class InspectionForm extends Component {
                             let obj = {
                                 resource: 'videos',
                                 id:id,
+                                isLocal:isLocal,
                                 report_id: this.props.selectedReport.report.report_id,
                                 subsection_id: this.props.navigation.state.params.subsectionID,
                                 operation: 'DELETE',
@@ -1059,7 +1060,13 @@ class InspectionForm extends Component {
                 successActionStatus: 201
             };
 
-            RNS3.put(file, options)
+            putMedia(file, options, (e) => {
+                this.setState({progress:e.loaded / e.total});
+                if(e.loaded / e.total === 1 ){
+                    this.setState({progress:0, textSms:'Media uploading..!'});
+                };
+                console.log(e.loaded / e.total);
+            })
                 .then(response => {
                     if (response.status !== 201)
                         throw new Error("Failed to upload image to S3");
@@ -1073,13 +1080,6 @@ class InspectionForm extends Component {
                     this.videoSent(response.body.postResponse.location, response.body.postResponse.key);
 
                     console.log('response from aws s3 video:', response.body);
-                })
-                .progress((e) => {
-                    this.setState({progress:e.loaded / e.total});
-                    if(e.loaded / e.total === 1 ){
-                        this.setState({progress:0, textSms:'Media uploading..!'});
-                    };
-                    console.log(e.loaded / e.total);
                 });
         }
         else{
@@ -1158,7 +1158,7 @@ class InspectionForm extends Component {
                 created_at: Moment(new Date(), "DD_MM_YYYY hh:mm a").format("YYYY-MM-DD HH:mm:ss"),
                 updated_at: Moment(new Date(), "DD_MM_YYYY hh:mm a").format("YYYY-MM-DD HH:mm:ss")
             },
-            isLocal: (this.props.selectedReport.report.data[key]) ? false : true
+            isLocal: (this.props.subsectionData) ? false : true
         };
 
         if(this.state.formdata.length === 0) {
@@ -1379,21 +1379,30 @@ class InspectionForm extends Component {
     }
 }
 
-const mapStateToProps = state => {
-    return {
-        elements: state.formelement.elements,
-        formdata: state.reportformdata.formdata,
-        image: state.reportformdata.image,
-        video: state.reportformdata.video,
-        userInfo:state.userlogin.userdata,
-        comments:state.appAllData.comments,
-        selectedReport: state.report.selectedReport,
-        isNetwork:state.appAllData.isNetwork,
-        organization_id:state.userlogin.organization_id,
+//comments and data of the subsection on screen only, edits elsewhere do not re-render the form
+const makeMapStateToProps = () => {
+    const selectSubsectionComments = makeSelectSubsectionComments();
+    const selectSubsectionData = makeSelectSubsectionData();
+
+    return (state, ownProps) => {
+        let subsectionID = ownProps.navigation.state.params.subsectionID;
+        return {
+            elements: state.formelement.elements,
+            formdata: state.reportformdata.formdata,
+            image: state.reportformdata.image,
+            video: state.reportformdata.video,
+            userInfo:state.userlogin.userdata,
+            comments:selectSubsectionComments(state, subsectionID),
+            subsectionData:selectSubsectionData(state, subsectionID),
+            selectedReport: state.report.selectedReport,
+            template: getSelectedTemplate(state),
+            isNetwork:state.appAllData.isNetwork,
+            organization_id:state.userlogin.organization_id,
+        };
     };
 };
 
-export default connect(mapStateToProps, {
+export default connect(makeMapStateToProps, {
     getFormElement,
     getReportData,
     addReportData,
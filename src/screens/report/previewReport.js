@@ -4,11 +4,11 @@ import {
     View,
     WebView,
     Dimensions,
-    AsyncStorage,
     Alert
 } from 'react-native';
 import Loader from '../../helper/loader';
 import Header from '../../screens/component/header';
+import { getSession } from '../../services/authSession';
 
 export default class Preview extends Component {
 
@@ -23,10 +23,9 @@ export default class Preview extends Component {
     }
 
     componentWillMount(){
-      AsyncStorage.getItem('user').then((value) => {
-        let result = JSON.parse(value);
+      getSession().then((user) => {
           this.setState({
-              token: result.token
+              token: user.token
           });
       }).catch((err)=>{
           console.log("123")
@@ -32,8 +32,10 @@ class ReportDetail extends Component{
     };
 
     onEdit = (objReport) => {
-        this.props.setSelectedReport(objReport.report_id, objReport.template_id);
-        this.props.navigation.navigate('EditReport');
+        this.props.setSelectedReport(objReport.report_id, objReport.template_id)
+            .then(() => {
+                this.props.navigation.navigate('EditReport');
+            });
     };
 
     onPreview = (objReport) => {
@@ -63,6 +65,7 @@ class ReportDetail extends Component{
                                 let obj = {
                                     resource:'report',
                                     id:objReport.report_id,
+                                    isLocal:objReport.isLocal,
                                     operation:'DELETE',
                                     operation_id: new Date().getTime(),
                                     record_timestamp: new Date().getTime()
@@ -179,7 +182,6 @@ class ReportDetail extends Component{
 }
 
 const mapStateToProps = state => {
-    console.log('updated data', state.appAllData.updatedData);
     return {
         isNetwork:state.appAllData.isNetwork
     };
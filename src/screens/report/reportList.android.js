@@ -27,6 +27,7 @@ import {
 import {
     setUpdatedData
 } from '../../actions/updatedAppDataAction';
+import { selectReportRows } from '../../selectors/appDataSelectors';
 import {NavigationActions} from "react-navigation";
 let isHidden = true;
 
@@ -51,8 +52,10 @@ class ReportList extends Component{
     };
 
     onEdit = (objReport) => {
-        this.props.setSelectedReport(objReport.report_id, objReport.template_id);
-        this.props.navigation.navigate('EditReport');
+        this.props.setSelectedReport(objReport.report_id, objReport.template_id)
+            .then(() => {
+                this.props.navigation.navigate('EditReport');
+            });
     };
 
     onPreview = (objReport) => {
@@ -82,6 +85,7 @@ class ReportList extends Component{
                                 let obj = {
                                     resource:'report',
                                     id:objReport.report_id,
+                                    isLocal:objReport.isLocal,
                                     operation:'DELETE',
                                     operation_id: new Date().getTime(),
                                     record_timestamp: new Date().getTime()
@@ -203,7 +207,7 @@ class ReportList extends Component{
 
 const mapStateToProps = state => {
     return {
-        reports: state.appAllData.reports,
+        reports: selectReportRows(state),
         isNetwork:state.appAllData.isNetwork
     };
 };
@@ -36,6 +36,7 @@ import {
 import {
     setUpdatedData
 } from '../../actions/updatedAppDataAction';
+import { selectReportRows } from '../../selectors/appDataSelectors';
 import {setUserLogout} from '../../actions/loginAction';
 import { Dimensions } from 'react-native';
 const {height, width} = Dimensions.get('window');
@@ -65,8 +66,10 @@ class ReportList extends Component{
     }
 
     onEdit = (objReport) => {
-        this.props.setSelectedReport(objReport.report_id, objReport.template_id);
-        this.props.navigation.navigate('EditReport');
+        this.props.setSelectedReport(objReport.report_id, objReport.template_id)
+            .then(() => {
+                this.props.navigation.navigate('EditReport');
+            });
     };
 
     onPreview = (objReport) => {
@@ -96,6 +99,7 @@ class ReportList extends Component{
                                 let obj = {
                                     resource:'report',
                                     id:objReport.report_id,
+                                    isLocal:objReport.isLocal,
                                     operation:'DELETE',
                                     operation_id: new Date().getTime(),
                                     record_timestamp: new Date().getTime()
@@ -364,9 +368,8 @@ class ReportList extends Component{
 }
 
 const mapStateToProps = state => {
-    console.log('updated data', state.appAllData.updatedData);
     return {
-        reports: state.appAllData.reports,
+        reports: selectReportRows(state),
         report_limit: state.userlogin.userdata.organization_setting.report_limit || "",
         email: state.userlogin.userdata.email || "",
         isNetwork:state.appAllData.isNetwork
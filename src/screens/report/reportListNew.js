@@ -12,7 +12,7 @@ import {
     TouchableOpacity,
     Animated,
     Easing,
-    AsyncStorage, Alert,
+    Alert,
     FlatList
 } from 'react-native';
 import { NavigationActions } from 'react-navigation'
@@ -36,6 +36,8 @@ import {
 } from "../../actions/sendReportAction";
 import { Dimensions } from 'react-native';
 import {reportListServices} from '../../realmServices/reportListServices';
+import { selectReportRows } from '../../selectors/appDataSelectors';
+import { clearSession } from '../../services/authSession';
 const {height, width} = Dimensions.get('window');
 const aspectRatio = height/width;
 const swipeimage = {
@@ -254,17 +256,11 @@ class ReportList extends Component{
 
     onLogOut = () => {
 
-        AsyncStorage.removeItem('user').then(res=>{
-            return AsyncStorage.removeItem('user');
-        }).then(res=>{
-            return AsyncStorage.removeItem('user');
-        }).catch(err=>{
-
-        });
-
-        AsyncStorage.removeItem('user', (err) => {
+        clearSession().then(() => {
             this.props.navigation.dispatch(navigateAction);
             return Promise.resolve(true)
+        }).catch(err=>{
+
         });
     };
 
@@ -279,9 +275,7 @@ class ReportList extends Component{
 
     setOpenedCell = (reportId) => {
         this.setState({
-            openedCell: reportId,
-            reportdata: _.cloneDeep(this.props.reportdata)
-
+            openedCell: reportId
         })
     };
 
@@ -354,7 +348,7 @@ class ReportList extends Component{
 
 const mapStateToProps = state => {
     return {
-        reports: state.appAllData.reports,
+        reports: selectReportRows(state),
         report_limit: state.userlogin.userdata.organization_setting.report_limit || "",
         email: state.userlogin.userdata.email || "",
     };
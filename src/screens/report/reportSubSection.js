@@ -21,7 +21,11 @@ import {
 import {
     sendReportData
 } from "../../actions/sendReportAction";
-let _ = require('lodash');
+import { getSelectedTemplate } from '../../selectors/appDataSelectors';
+import {
+    getCompiledSection,
+    getCompiledSubsections
+} from '../../services/templateIndex';
 
 class ReportSubSection extends Component{
     constructor(props){
@@ -41,13 +45,11 @@ class ReportSubSection extends Component{
     };
 
     componentDidMount(){
-        let selectedSubSections = _.find(this.props.selectedReport.template.sections, { section_id: this.props.navigation.state.params.sectionId });
-        if(selectedSubSections !== undefined){
-            if(selectedSubSections.subsections){
-                this.setState({
-                    reportSectionData:selectedSubSections.subsections,
-                });
-            }
+        let sectionId = this.props.navigation.state.params.sectionId;
+        if(getCompiledSection(this.props.template, sectionId) !== undefined){
+            this.setState({
+                reportSectionData:getCompiledSubsections(this.props.template, sectionId),
+            });
         }
     }
 
@@ -179,6 +181,7 @@ class ReportSubSection extends Component{
 const mapStateToProps = state => {
     return {
         selectedReport: state.report.selectedReport,
+        template: getSelectedTemplate(state),
         report_limit: state.userlogin.userdata.organization_setting.report_limit || "",
         email: state.userlogin.userdata.email || "",
     };
@@ -0,0 +1,51 @@
+import {
+    createSelector,
+    createListCache
+} from '../services/selector';
+
+const EMPTY_LIST = [];
+
+const getReports = (state) => state.appAllData.reports;
+const getComments = (state) => state.appAllData.comments;
+const getSubsectionId = (state, subsectionID) => subsectionID;
+
+export const getSelectedReport = (state) => state.report.selectedReport;
+
+const getSelectedReportData = (state) => {
+    let report = state.report.selectedReport.report;
+    return report ? report.data : undefined;
+};
+
+//Report list rows carry only what the list renders and its actions need, a change inside the
+//data of a report keeps every row, and the list, as it was
+const toReportRow = (report) => {
+    return {
+        id: report.id,
+        report_id: report.report_id,
+        template_id: report.template_id,
+        name: report.name,
+        isLocal: report.isLocal,
+        property: report.property
+    };
+};
+const reportRowCache = createListCache((row) => row.report_id);
+
+export const selectReportRows = createSelector(getReports, (reports) => {
+    return reportRowCache((reports || EMPTY_LIST).map(toReportRow));
+});
+
+//Compiled template (services/templateIndex), its `source` is the template itself
+export const getCompiledTemplate = (state, template_id) => state.entities.templates[template_id];
+
+export const getSelectedTemplate = (state) => {
+    let template = state.report.selectedReport.template;
+    return template ? state.entities.templates[template.template_id] : undefined;
+};
+
+//Per component instances, selected with the subsection id of the screen
+
+export const makeSelectSubsectionComments = () => createSelector(getComments, getSubsectionId,
+    (comments, subsectionID) => (comments && comments['subsection_' + subsectionID]) || EMPTY_LIST);
+
+export const makeSelectSubsectionData = () => createSelector(getSelectedReportData, getSubsectionId,
+    (data, subsectionID) => (data && data['subsection_' + subsectionID]) || undefined);
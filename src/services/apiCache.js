@@ -0,0 +1,191 @@
+import { AsyncStorage } from 'react-native';
+import Constant from '../helper/constant';
+
+//Cache of GET response bodies, in memory and in AsyncStorage.
+//
+//An entry is {body, etag, time}, keyed by url. It is served without a request for apiCacheTtl
+//ms after it was fetched or revalidated, after that it is revalidated with its ETag. A write
+//(post, put, delete) drops the entries of the resources it changed, see invalidateCache, so
+//lists read after an upload are fetched again. The memory keeps the apiCacheMaxEntries most
+//recently used entries, evicted entries are removed from storage too.
+
+const PREFIX = 'apiCache:';
+const MAX_INVALIDATIONS = 100;
+
+let entries = new Map();    //url -> entry, least recently used first
+let storedKeys = new Set(); //urls with an entry in storage, completed once from getAllKeys
+let indexing = null;
+let generation = 0;         //number of invalidations so far
+let invalidations = [];     //{generation, matches} of the last MAX_INVALIDATIONS writes
+
+const getSegments = (url) => {
+    return url.replace(/^[a-z]+:\/\/[^\/]+/i, '').split('?')[0].split('/').filter((segment) => segment !== '');
+};
+
+const startsWith = (path, segments) => {
+    return segments.length <= path.length && segments.every((segment, i) => path[i] === segment);
+};
+
+//true when `segments` appear in a row in `path`
+const containsSegments = (path, segments) => {
+    for (let start = 0; start + segments.length <= path.length; start++) {
+        let i = 0;
+        while (i < segments.length && path[start + i] === segments[i]) {
+            i++;
+        }
+        if (i === segments.length) {
+            return true;
+        }
+    }
+    return false;
+};
+
+const loadStoredKeys = () => {
+    if (indexing === null) {
+        indexing = AsyncStorage.getAllKeys()
+            .then((keys) => {
+                keys.forEach((key) => {
+                    if (key.indexOf(PREFIX) === 0) {
+                        storedKeys.add(key.slice(PREFIX.length));
+                    }
+                });
+                return storedKeys;
+            })
+            .catch((error) => {
+                console.log('api cache keys unreadable', error);
+                indexing = null;
+                return storedKeys;
+            });
+    }
+    return indexing;
+};
+
+const remove = (keys) => {
+    keys.forEach((key) => {
+        storedKeys.delete(key);
+    });
+    if (keys.length !== 0) {
+        AsyncStorage.multiRemove(keys.map((key) => PREFIX + key)).catch((error) => {
+            console.log('api cache remove failed', error);
+        });
+    }
+};
+
+const remember = (url, entry) => {
+    entries.delete(url);
+    entries.set(url, entry);
+
+    let evicted = [];
+    while (entries.size > Constant.apiCacheMaxEntries) {
+        let oldest = entries.keys().next().value;
+        entries.delete(oldest);
+        evicted.push(oldest);
+    }
+    remove(evicted);
+};
+
+//Resolves the entry of `url` or undefined
+export const readCache = (url) => {
+    let entry = entries.get(url);
+    if (entry !== undefined) {
+        remember(url, entry);
+        return Promise.resolve(entry);
+    }
+    return AsyncStorage.getItem(PREFIX + url)
+        .then((value) => {
+            if (value === null) {
+                return undefined;
+            }
+            //a write may have dropped the entry while it was read
+            if (!entries.has(url)) {
+                remember(url, JSON.parse(value));
+            }
+            return entries.get(url);
+        })
+        .catch((error) => {
+            console.log('api cache unreadable', error);
+            return undefined;
+        });
+};
+
+export const isFresh = (entry) => {
+    return Date.now() - entry.time < Constant.apiCacheTtl;
+};
+
+//Taken before a request, a response is not written when a write dropped its url meanwhile
+export const getCacheGeneration = () => {
+    return generation;
+};
+
+const isInvalidatedSince = (url, since) => {
+    if (since === undefined || since === generation) {
+        return false;
+    }
+    //older than the invalidations kept, it may have been dropped
+    if (invalidations.length === 0 || since < invalidations[0].generation - 1) {
+        return true;
+    }
+    let segments = getSegments(url);
+    return invalidations.some((invalidation) => invalidation.generation > since && invalidation.matches(segments));
+};
+
+export const writeCache = (url, body, etag, since) => {
+    if (isInvalidatedSince(url, since)) {
+        return undefined;
+    }
+    let entry = {body: body, etag: etag, time: Date.now()};
+    remember(url, entry);
+    storedKeys.add(url);
+    AsyncStorage.setItem(PREFIX + url, JSON.stringify(entry)).catch((error) => {
+        console.log('api cache write failed', error);
+    });
+    return entry;
+};
+
+//The server answered 304, the entry is fresh again
+export const revalidateCache = (url, entry, since) => {
+    return writeCache(url, entry.body, entry.etag, since);
+};
+
+//Drops the entries a write to `url` may have changed: `url` and everything below it, the list
+//one level up, and the entries with one of the `related` resource paths anywhere in their path
+//('report/12' drops report/12/property and reportsubsection/3/images/report/12)
+export const invalidateCache = (url, related) => {
+    let written = getSegments(url);
+    let parent = written.slice(0, -1);
+    let resources = (related || []).map(getSegments).filter((segments) => segments.length !== 0);
+
+    const matches = (segments) => {
+        return startsWith(segments, written) ||
+            (segments.length === parent.length && startsWith(segments, parent)) ||
+            resources.some((resource) => containsSegments(segments, resource));
+    };
+
+    generation++;
+    invalidations.push({generation: generation, matches: matches});
+    if (invalidations.length > MAX_INVALIDATIONS) {
+        invalidations.shift();
+    }
+
+    entries.forEach((entry, key) => {
+        if (matches(getSegments(key))) {
+            entries.delete(key);
+        }
+    });
+    return loadStoredKeys().then((keys) => {
+        let dropped = [];
+        keys.forEach((key) => {
+            if (matches(getSegments(key))) {
+                dropped.push(key);
+            }
+        });
+        remove(dropped);
+    });
+};
+
+export const clearApiCache = () => {
+    entries = new Map();
+    return loadStoredKeys().then((keys) => {
+        remove(Array.from(keys));
+    });
+};
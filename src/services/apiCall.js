@@ -1,72 +1,267 @@
-
 import axios from 'axios'
+import RNFetchBlob from 'react-native-fetch-blob';
+import { Answers } from 'react-native-fabric';
+import Constant from '../helper/constant';
+import {
+    gzipText,
+    toBase64
+} from './compress';
+import {
+    getSession,
+    refreshSession
+} from './authSession';
+import {
+    readCache,
+    isFresh,
+    getCacheGeneration,
+    writeCache,
+    revalidateCache,
+    invalidateCache
+} from './apiCache';
+import {
+    schedule,
+    PRIORITY_INTERACTIVE
+} from './requestScheduler';
+import { withRetry } from './retryPolicy';
+
+let pendingGets = {};      //authorization + url -> promise of the response body
+let plainEndpoints = {};   //url without query -> true once it refused a gzip body
+
+const isCacheable = (response) => {
+    let cacheControl = response.headers && response.headers['cache-control'];
+    return response.status === 200 && !(cacheControl && cacheControl.indexOf('no-store') !== -1);
+};
+
+//Identical GETs in flight share one request. Bodies come from services/apiCache while fresh,
+//stale ones are revalidated with If-None-Match. `useCache` false only shares in flight requests.
+const cachedGet = (url, config, useCache, priority) => {
+    let key = (config.headers.Authorization || "") + " " + url;
+    if (pendingGets[key] !== undefined) {
+        return pendingGets[key];
+    }
+
+    let generation = getCacheGeneration();
+    let pending = (useCache ? readCache(url) : Promise.resolve(undefined)).then((entry) => {
+        if (entry !== undefined && isFresh(entry)) {
+            return entry.body;
+        }
+        let headers = config.headers;
+        if (entry !== undefined && entry.etag) {
+            headers = Object.assign({}, headers, {"If-None-Match": entry.etag});
+        }
+        return withRetry(() => schedule(priority, () => axios.get(url, Object.assign({}, config, {
+            headers: headers,
+            validateStatus: (status) => (status >= 200 && status < 300) || status === 304
+        })))).then((response) => {
+            if (response.status === 304 && entry !== undefined) {
+                revalidateCache(url, entry, generation);
+                return entry.body;
+            }
+            if (useCache && isCacheable(response)) {
+                writeCache(url, response.data, response.headers.etag, generation);
+            }
+            return response.data;
+        });
+    });
+
+    const done = () => {
+        delete pendingGets[key];
+    };
+    pendingGets[key] = pending;
+    pending.then(done, done);
+    return pending;
+};
+
+//A successful write drops the cached responses of what it changed, see invalidateCache. A body
+//about one report also drops the reads of that report.
+const invalidateOnWrite = (url, data, related, pending) => {
+    if (related === undefined) {
+        related = (data && data.report_id !== undefined) ? [Constant.reportDel + data.report_id] : [];
+    }
+    return pending.then((response) => {
+        invalidateCache(url, related);
+        return response;
+    });
+};
+
+const isJsonBody = (data) => {
+    if (data === null || typeof data !== 'object') {
+        return false;
+    }
+    return !(typeof FormData !== 'undefined' && data instanceof FormData);
+};
+
+const parseBody = (text) => {
+    try {
+        return JSON.parse(text);
+    } catch (e) {
+        return text;
+    }
+};
+
+//Sends gzip bytes. XMLHttpRequest of this React Native version only sends strings and FormData,
+//react-native-fetch-blob decodes a body whose Content-Type ends in ;BASE64 and sends the bytes.
+//Resolves and rejects like axios, a status outside 2xx rejects with err.response.
+const sendBytes = (url, type, bytes, headers) => {
+    return RNFetchBlob.fetch(type.toUpperCase(), url, Object.assign({}, headers, {
+        "Content-Type": "application/json;BASE64",
+        "Content-Encoding": "gzip"
+    }), toBase64(bytes)).then((res) => {
+        let info = res.info();
+        let responseHeaders = {};
+        Object.keys(info.headers || {}).forEach((name) => {
+            responseHeaders[name.toLowerCase()] = info.headers[name];
+        });
+        let response = {status: info.status, headers: responseHeaders, data: parseBody(res.text()), config: {data: bytes}};
+        if (info.status >= 200 && info.status < 300) {
+            return response;
+        }
+        let err = new Error('Request failed with status code ' + info.status);
+        err.response = response;
+        return Promise.reject(err);
+    });
+};
+
+//The plain body is sent instead, the event shows endpoints and servers that do not take gzip
+const reportGzipRefused = (endpoint, status) => {
+    try {
+        Answers.logCustom('Gzip Refused', {endpoint: endpoint, status: status});
+    } catch (e) {
+        console.log('gzip refused', endpoint, status);
+    }
+};
+
+//post or put. With `compress` a JSON body of compressMinBytes or more is sent gzipped. An
+//endpoint that answers 415 gets the plain body and only plain bodies from then on. One that
+//answers 400 or 422, which servers without gzip support send for a body they cannot read, gets
+//the plain body once and is sent plain bodies from then on when that is accepted. Both are
+//reported. `canRetry` repeats the request after network and server errors, see
+//services/retryPolicy.
+const write = (url, type, data, config, compress, priority, canRetry) => {
+    const retry = (run) => canRetry ? withRetry(run) : run();
+    const send = (body, headers) => retry(() => schedule(priority, () => axios[type](url, body, Object.assign({}, config, {headers: headers}))));
 
+    let endpoint = url.split('?')[0];
+    let text = (compress && !plainEndpoints[endpoint] && isJsonBody(data)) ? JSON.stringify(data) : null;
+    if (text === null || text.length < Constant.compressMinBytes) {
+        return send(data, config.headers);
+    }
 
-export function CallApi(url,type='get',data={},header={}) {
+    return gzipText(text)
+        .then((bytes) => retry(() => schedule(priority, () => sendBytes(url, type, bytes, config.headers))))
+        .catch((err) => {
+            let status = err && err.response && err.response.status;
+            if (status === 415) {
+                plainEndpoints[endpoint] = true;
+                reportGzipRefused(endpoint, status);
+                return send(data, config.headers);
+            }
+            if (status === 400 || status === 422) {
+                return send(data, config.headers).then((response) => {
+                    plainEndpoints[endpoint] = true;
+                    reportGzipRefused(endpoint, status);
+                    return response;
+                });
+            }
+            return Promise.reject(err);
+        });
+};
 
-    let reqHeader = Object.assign(header,{"Accept":''});
+//get resolves with the response body, the other types with the whole response
+const request = (url, type, data, header, options) => {
+    options = options || {};
+    let config = {headers: Object.assign({}, header, {"Accept":''})};
+    let priority = options.priority || PRIORITY_INTERACTIVE;
+    let compress = !!options.compress;
+    if (options.idempotencyKey) {
+        config.headers["Idempotency-Key"] = options.idempotencyKey;
+    }
     if(type === 'get'){
-        return axios.get(url, {headers: reqHeader})
-            .then((response) => {
-                return Promise.resolve(response.data)
-            })
-            .catch((err) => {
-                switch (err.response.data.status_code){
-
-                    case 401:
-                        return Promise.reject(err.response.data.data);
-
-                    default:
-                        return Promise.reject(err);
-                }
-            });
+        return cachedGet(url, config, options.cache !== false, priority);
     }else if(type === 'post'){
-        return axios.post(url,data,{headers: reqHeader})
-            .then((response) => {
-                return Promise.resolve(response)
-            })
-            .catch((err) => {
-                switch (err.response.data.status_code){
-                    case 401:
-                        return Promise.reject(err.response.data.data);
-                    case 409:
-                        return Promise.reject(err.response.data.data);
-                    default:
-                        return Promise.reject(err);
-                }
-            });
+        return invalidateOnWrite(url, data, options.invalidate, write(url, 'post', data, config, compress, priority, !!options.idempotencyKey));
+    }else if(type === 'delete'){
+        return invalidateOnWrite(url, data, options.invalidate, withRetry(() => schedule(priority, () => axios.delete(url, config))));
+    }else if(type === 'put'){
+        return invalidateOnWrite(url, data, options.invalidate, write(url, 'put', data, config, compress, priority, true));
     }
-    else if(type === 'delete'){
-        return axios.delete(url,{headers:reqHeader})
-            .then((response) => {
-                return Promise.resolve(response)
-            })
-            .catch((err) => {
-                switch (err.response.data.status_code){
-                    case 401:
-                        return Promise.reject(err.response.data.data);
-                    case 409:
-                        return Promise.reject(err.response.data.data);
-                    default:
-                        return Promise.reject(err);
-                }
-            });
+    return Promise.reject(new Error('unknown request type ' + type));
+};
+
+const getStatusCode = (err) => {
+    return (err && err.response && err.response.data) ? err.response.data.status_code : undefined;
+};
+
+const isUnauthorized = (err) => {
+    return getStatusCode(err) === 401 || (err && err.response && err.response.status === 401);
+};
+
+//401, and 409 for writes, reject with the message the server sent unless `rawError` is set
+const toError = (err, type, rawError) => {
+    let status = getStatusCode(err);
+    if (!rawError && (status === 401 || (status === 409 && type !== 'get'))) {
+        return Promise.reject(err.response.data.data);
     }
-    else if(type === 'put'){
-        return axios.put(url,data,{headers:reqHeader})
-            .then((response) => {
-                return Promise.resolve(response)
-            })
-            .catch((err) => {
-                switch (err.response.data.status_code){
-                    case 401:
-                        return Promise.reject(err.response.data.data);
-                    case 409:
-                        return Promise.reject(err.response.data.data);
-                    default:
-                        return Promise.reject(err);
-                }
-            });
+    return Promise.reject(err);
+};
+
+const getUtf8Length = (text) => {
+    let length = 0;
+    for (let i = 0; i < text.length; i++) {
+        let code = text.charCodeAt(i);
+        if (code < 0x80) {
+            length += 1;
+        } else if (code < 0x800) {
+            length += 2;
+        } else if (code >= 0xD800 && code <= 0xDBFF) {
+            length += 4;
+            i++;
+        } else {
+            length += 3;
+        }
+    }
+    return length;
+};
+
+//Bytes of the request body a response answers, as sent on the wire (after gzip)
+export const getSentBytes = (response) => {
+    let data = response && response.config ? response.config.data : undefined;
+    if (data === undefined || data === null) {
+        return 0;
     }
+    if (typeof data === 'string') {
+        return getUtf8Length(data);
+    }
+    return data.byteLength || data.length || 0;
+};
+
+//`options.cache` false keeps a GET out of the response cache, for responses that are not read twice.
+//`options.priority` is the class of services/requestScheduler the request runs in, interactive by default.
+//`options.compress` sends a post or put JSON body gzipped where the endpoint accepts it.
+//`options.idempotencyKey` is sent as Idempotency-Key and lets a post be retried like the other types.
+//`options.invalidate` lists the resource paths a write changes ('report/12'), in place of the report of its body.
+//`options.rawError` rejects with the axios error, for callers that classify it with services/retryPolicy.
+export function CallApi(url,type='get',data={},header={},options={}) {
+    return request(url, type, data, header, options)
+        .catch((err) => toError(err, type, options.rawError));
 }
 
+//Same as CallApi with the Authorization header of the signed in user. A 401 signs in again
+//once and repeats the request with the new token, see services/authSession.
+export function CallAuthApi(url,type='get',data={},header={},options={}) {
+    return getSession()
+        .then((user) => {
+            let token = (user && user.token) || "";
+            const send = (value) => request(url, type, data, Object.assign({}, header, {"Authorization": "Bearer " + value}), options);
+
+            return send(token).catch((err) => {
+                if (!isUnauthorized(err)) {
+                    return Promise.reject(err);
+                }
+                return refreshSession(token)
+                    .catch(() => Promise.reject(err))
+                    .then((session) => send(session.token));
+            });
+        })
+        .catch((err) => toError(err, type, options.rawError));
+}
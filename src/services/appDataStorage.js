@@ -0,0 +1,381 @@
+import {
+    AsyncStorage,
+    AppState,
+    InteractionManager
+} from 'react-native';
+import Constant from '../helper/constant';
+import { decode } from './compactJson';
+
+//Persistence of appAllData in shards.
+//
+//redux-persist wrote appAllData as one value, so saving a field rewrote every report. Here each
+//report, template and comment list is its own AsyncStorage key and only the shards whose object
+//changed since the last write are written again. Updates share unchanged objects with the
+//previous state (services/immutable), so a shard is dirty exactly when its object is new.
+//  appData:index                   {reports: [summary], templates: [summary],
+//                                   comments: [subsection_<id>], dataLoaded, summaries: true}
+//  appData:report:<report_id>
+//  appData:template:<template_id>
+//  appData:comments:subsection_<id>
+//Shards are plain JSON, startup and opening a report read them. Shards written in the compact
+//encoding of services/compactJson by earlier versions are still read.
+//The sync queue is kept apart in its own checkpoint and journal files, see services/syncJournal.
+//
+//Startup reads only the index. Reports and templates enter the store as summaries (the fields
+//the lists show, flagged `isSummary`) and their bodies are read with loadReportBody and
+//loadTemplateBody when a report is opened. Summaries are never written over their shards: the
+//fields changed on a summary (a field set from the report list, an image_path acknowledged by
+//the server) are patched into the stored body, and into a body read before that write.
+//
+//Writes are behind the store: changes within persistWriteDelay ms are coalesced into one write,
+//which runs after running interactions. It is written at once when persistMaxDirty shards are
+//waiting, and when the app goes to the background or gets a memory warning.
+
+const PREFIX = 'appData:';
+const INDEX_KEY = PREFIX + 'index';
+const LEGACY_KEY = 'reduxPersist:appAllData';
+
+const REPORT_SUMMARY_FIELDS = ['id', 'report_id', 'template_id', 'name', 'isLocal', 'inspection_date_time'];
+const PROPERTY_SUMMARY_FIELDS = ['address', 'city', 'state', 'zip', 'optimized_img'];
+const TEMPLATE_SUMMARY_FIELDS = ['template_id', 'name'];
+
+const reportKey = (report_id) => PREFIX + 'report:' + report_id;
+const templateKey = (template_id) => PREFIX + 'template:' + template_id;
+const commentsKey = (key) => PREFIX + 'comments:' + key;
+
+let store = null;
+let unsubscribe = null;
+let written = null;             //appAllData as last handed to storage
+let dirty = {};                 //storage key -> object to write, null to remove
+let patches = {};               //storage key -> {base, next} summaries to patch the stored body with
+let isIndexDirty = false;
+let isLegacyPending = false;
+let isFlushScheduled = false;
+let flushTimer = null;
+let writeChain = Promise.resolve();
+let loadedBodies = new WeakSet();  //bodies read from their shard, identical to what is stored
+
+const parse = (value) => {
+    if (value === null || value === undefined) {
+        return undefined;
+    }
+    try {
+        return decode(value);
+    } catch (e) {
+        console.log('app data shard unreadable', e);
+        return undefined;
+    }
+};
+
+const pick = (source, fields) => {
+    let result = {};
+    fields.forEach((field) => {
+        if (source[field] !== undefined) {
+            result[field] = source[field];
+        }
+    });
+    return result;
+};
+
+const getReportSummary = (report) => {
+    let summary = pick(report, REPORT_SUMMARY_FIELDS);
+    if (report.property) {
+        summary.property = pick(report.property, PROPERTY_SUMMARY_FIELDS);
+    }
+    summary.isSummary = true;
+    return summary;
+};
+
+const getTemplateSummary = (template) => {
+    let summary = pick(template, TEMPLATE_SUMMARY_FIELDS);
+    summary.isSummary = true;
+    return summary;
+};
+
+const isPlainObject = (value) => value !== null && typeof value === 'object' && !Array.isArray(value);
+
+//Applies the fields changed from summary `base` to `next` to `body`. Summaries hold only part of
+//nested objects (property), those are patched field by field.
+const patchBody = (body, base, next) => {
+    let result = Object.assign({}, body);
+    Object.keys(next).forEach((key) => {
+        if (key === 'isSummary' || next[key] === base[key]) {
+            return;
+        }
+        result[key] = (isPlainObject(next[key]) && isPlainObject(body[key]))
+            ? patchBody(body[key], isPlainObject(base[key]) ? base[key] : {}, next[key])
+            : next[key];
+    });
+    return result;
+};
+
+//Marks the entries of `next` that are not identical to the ones in `previous`, returns true when
+//the index has to be written again (an entry was added, removed, moved or its summary changed)
+const diffList = (previous, next, idKey, toKey, summarize) => {
+    if (previous === next) {
+        return false;
+    }
+    let before = {};
+    (previous || []).forEach((item) => {
+        before[item[idKey]] = item;
+    });
+
+    let isIndexChanged = (previous || []).length !== (next || []).length;
+    (next || []).forEach((item, index) => {
+        let id = item[idKey];
+        let old = before[id];
+        if (old !== item && !item.isSummary && !loadedBodies.has(item)) {
+            dirty[toKey(id)] = item;
+            delete patches[toKey(id)];
+            isIndexChanged = isIndexChanged || old === undefined ||
+                JSON.stringify(summarize(old)) !== JSON.stringify(summarize(item));
+        } else if (old !== item && item.isSummary && old !== undefined && old.isSummary) {
+            let patch = patches[toKey(id)];
+            patches[toKey(id)] = {base: patch ? patch.base : old, next: item};
+            isIndexChanged = isIndexChanged ||
+                JSON.stringify(summarize(old)) !== JSON.stringify(summarize(item));
+        }
+        if (!isIndexChanged && previous[index][idKey] !== id) {
+            isIndexChanged = true;
+        }
+        delete before[id];
+    });
+
+    Object.keys(before).forEach((id) => {
+        dirty[toKey(id)] = null;
+        delete patches[toKey(id)];
+        isIndexChanged = true;
+    });
+    return isIndexChanged;
+};
+
+const diffComments = (previous, next) => {
+    if (previous === next) {
+        return false;
+    }
+    previous = previous || {};
+    next = next || {};
+
+    let isKeysChanged = false;
+    Object.keys(next).forEach((key) => {
+        if (previous[key] !== next[key]) {
+            dirty[commentsKey(key)] = next[key];
+            isKeysChanged = isKeysChanged || !previous.hasOwnProperty(key);
+        }
+    });
+    Object.keys(previous).forEach((key) => {
+        if (!next.hasOwnProperty(key)) {
+            dirty[commentsKey(key)] = null;
+            isKeysChanged = true;
+        }
+    });
+    return isKeysChanged;
+};
+
+const getIndex = (appAllData) => {
+    return {
+        reports: (appAllData.reports || []).map(getReportSummary),
+        templates: (appAllData.templates || []).map(getTemplateSummary),
+        comments: Object.keys(appAllData.comments || {}),
+        dataLoaded: appAllData.dataLoaded,
+        summaries: true
+    };
+};
+
+//Reads the shards of changed summaries and writes them back with the changes
+const writePatches = (pending) => {
+    let keys = Object.keys(pending);
+    if (keys.length === 0) {
+        return null;
+    }
+    return AsyncStorage.multiGet(keys).then((results) => {
+        let pairs = [];
+        results.forEach(([key, shard]) => {
+            let body = parse(shard);
+            if (body !== undefined) {
+                pairs.push([key, JSON.stringify(patchBody(body, pending[key].base, pending[key].next))]);
+            }
+        });
+        return (pairs.length !== 0) ? AsyncStorage.multiSet(pairs) : null;
+    });
+};
+
+const flush = () => {
+    if (flushTimer !== null) {
+        clearTimeout(flushTimer);
+        flushTimer = null;
+    }
+    isFlushScheduled = false;
+
+    let appAllData = written;
+    let pairs = [];
+    let removed = [];
+    Object.keys(dirty).forEach((key) => {
+        if (dirty[key] === null) {
+            removed.push(key);
+        } else {
+            pairs.push([key, JSON.stringify(dirty[key])]);
+        }
+    });
+    if (isIndexDirty) {
+        pairs.push([INDEX_KEY, JSON.stringify(getIndex(appAllData))]);
+    }
+    let removeLegacy = isLegacyPending;
+    let pending = patches;
+
+    dirty = {};
+    patches = {};
+    isIndexDirty = false;
+    isLegacyPending = false;
+
+    writeChain = writeChain
+        .then(() => (pairs.length !== 0) ? AsyncStorage.multiSet(pairs) : null)
+        .then(() => (removed.length !== 0) ? AsyncStorage.multiRemove(removed) : null)
+        .then(() => removeLegacy ? AsyncStorage.removeItem(LEGACY_KEY) : null)
+        .then(() => writePatches(pending))
+        .catch((error) => {
+            //the shards are written again with the next change
+            console.log('app data write failed', error);
+            written = {};
+        });
+    return writeChain;
+};
+
+const onStoreChange = () => {
+    let appAllData = store.getState().appAllData;
+    if (appAllData === written) {
+        return;
+    }
+    let previous = written || {};
+
+    let isIndexChanged = diffList(previous.reports, appAllData.reports, 'report_id', reportKey, getReportSummary);
+    isIndexChanged = diffList(previous.templates, appAllData.templates, 'template_id', templateKey, getTemplateSummary) || isIndexChanged;
+    isIndexChanged = diffComments(previous.comments, appAllData.comments) || isIndexChanged;
+    isIndexDirty = isIndexDirty || isIndexChanged || previous.dataLoaded !== appAllData.dataLoaded;
+    written = appAllData;
+
+    let dirtyCount = Object.keys(dirty).length + Object.keys(patches).length;
+    if (dirtyCount >= Constant.persistMaxDirty) {
+        flush();
+    } else if (!isFlushScheduled && (isIndexDirty || dirtyCount !== 0)) {
+        isFlushScheduled = true;
+        flushTimer = setTimeout(() => {
+            flushTimer = null;
+            InteractionManager.runAfterInteractions(() => {
+                if (isFlushScheduled) {
+                    flush();
+                }
+            });
+        }, Constant.persistWriteDelay);
+    }
+};
+
+const onAppStateChange = (state) => {
+    if (state === 'background') {
+        flushAppData();
+    }
+};
+
+const onMemoryWarning = () => {
+    flushAppData();
+};
+
+//Reads the persisted appAllData, resolves undefined when nothing was stored yet.
+//Data written by redux-persist before the shards existed is returned with `isLegacy`.
+export const loadAppData = () => {
+    return AsyncStorage.getItem(INDEX_KEY)
+        .then((value) => {
+            let index = parse(value);
+            if (index === undefined) {
+                return AsyncStorage.getItem(LEGACY_KEY).then((legacy) => {
+                    let data = parse(legacy);
+                    return data && Object.assign({}, data, {isLegacy: true});
+                });
+            }
+
+            //indexes written before summaries list plain ids, their shards are all read at once
+            let isSummary = !!index.summaries;
+            let keys = index.comments.map(commentsKey);
+            if (!isSummary) {
+                keys = keys.concat(index.reports.map(reportKey)).concat(index.templates.map(templateKey));
+            }
+
+            return AsyncStorage.multiGet(keys).then((results) => {
+                let values = {};
+                results.forEach(([key, shard]) => {
+                    values[key] = parse(shard);
+                });
+
+                let comments = {};
+                index.comments.forEach((key) => {
+                    if (values[commentsKey(key)] !== undefined) {
+                        comments[key] = values[commentsKey(key)];
+                    }
+                });
+                if (isSummary) {
+                    return {
+                        reports: index.reports,
+                        templates: index.templates,
+                        comments: comments,
+                        dataLoaded: index.dataLoaded
+                    };
+                }
+                return {
+                    reports: index.reports.map((id) => values[reportKey(id)]).filter((report) => report !== undefined),
+                    templates: index.templates.map((id) => values[templateKey(id)]).filter((template) => template !== undefined),
+                    comments: comments,
+                    dataLoaded: index.dataLoaded
+                };
+            });
+        })
+        .catch((error) => {
+            console.log('app data unreadable', error);
+            return undefined;
+        });
+};
+
+//A body is read after the writes already started, changes of its summary not written yet are
+//applied to it and it is written as a whole with the next flush
+const loadBody = (key) => {
+    return writeChain.then(() => AsyncStorage.getItem(key)).then((value) => {
+        let body = parse(value);
+        let patch = patches[key];
+        if (body !== undefined && patch !== undefined) {
+            body = patchBody(body, patch.base, patch.next);
+        } else if (body !== undefined) {
+            loadedBodies.add(body);
+        }
+        return body;
+    });
+};
+
+export const loadReportBody = (report_id) => {
+    return loadBody(reportKey(report_id));
+};
+
+export const loadTemplateBody = (template_id) => {
+    return loadBody(templateKey(template_id));
+};
+
+//Starts writing store changes. `isLegacy` rewrites everything as shards and drops the old value.
+export const startAppDataStorage = (appStore, isLegacy) => {
+    if (unsubscribe !== null) {
+        unsubscribe();
+    } else {
+        AppState.addEventListener('change', onAppStateChange);
+        AppState.addEventListener('memoryWarning', onMemoryWarning);
+    }
+    store = appStore;
+    written = isLegacy ? {} : store.getState().appAllData;
+    isLegacyPending = !!isLegacy;
+    unsubscribe = store.subscribe(onStoreChange);
+    onStoreChange();
+};
+
+//Resolves once every change seen so far is in storage
+export const flushAppData = () => {
+    if (isFlushScheduled) {
+        return flush();
+    }
+    return writeChain;
+};
@@ -0,0 +1,103 @@
+import { AsyncStorage } from 'react-native';
+import axios from 'axios';
+import Constant from '../helper/constant';
+
+//Signed in user, kept in memory.
+//
+//The user (token, credentials, organization) is stored under the `user` key by the login. It
+//is read from storage once and served from memory afterwards, so requests do not read and
+//parse it again. A request answered with 401 signs in again with the stored credentials,
+//concurrent requests share one sign in.
+
+const USER_KEY = 'user';
+
+let user = undefined;       //undefined until read, null when signed out
+let reading = null;
+let refreshing = null;
+let refreshListener = null;
+
+export const getSession = () => {
+    if (user !== undefined) {
+        return Promise.resolve(user);
+    }
+    if (reading === null) {
+        reading = AsyncStorage.getItem(USER_KEY)
+            .then((value) => {
+                if (user === undefined) {
+                    user = (value !== null) ? JSON.parse(value) : null;
+                }
+                return user;
+            })
+            .catch((error) => {
+                console.log('user unreadable', error);
+                return null;
+            })
+            .then((result) => {
+                reading = null;
+                return result;
+            });
+    }
+    return reading;
+};
+
+export const setSession = (value) => {
+    user = value;
+    return AsyncStorage.setItem(USER_KEY, JSON.stringify(value));
+};
+
+export const clearSession = () => {
+    user = null;
+    return AsyncStorage.removeItem(USER_KEY);
+};
+
+export const getAuthHeader = () => {
+    return getSession().then((value) => {
+        return {"Authorization": "Bearer " + ((value && value.token) || "")};
+    });
+};
+
+//Called with the sign in response after a refresh, so the store picks up the new token
+export const setRefreshListener = (listener) => {
+    refreshListener = listener;
+};
+
+//Signs in again unless the token was already replaced since `staleToken` was sent
+export const refreshSession = (staleToken) => {
+    if (refreshing !== null) {
+        return refreshing;
+    }
+    return getSession().then((value) => {
+        if (!value || !value.email || !value.password) {
+            return Promise.reject(new Error('not signed in'));
+        }
+        if (value.token !== staleToken) {
+            return value;
+        }
+        if (refreshing !== null) {
+            return refreshing;
+        }
+
+        refreshing = axios.post(Constant.baseurl + Constant.signin,
+            {"email": value.email, "password": value.password, "isMobile": true}, {headers: {"Accept": ''}})
+            .then((response) => {
+                refreshing = null;
+                let data = response.data;
+                let next = Object.assign({}, value, {
+                    token: data.token,
+                    username: data.user.username,
+                    organization_id: data.user.organization_id,
+                    profileimage: data.user.image_path,
+                });
+                setSession(next);
+                if (refreshListener !== null) {
+                    refreshListener(data);
+                }
+                return next;
+            })
+            .catch((error) => {
+                refreshing = null;
+                return Promise.reject(error);
+            });
+        return refreshing;
+    });
+};
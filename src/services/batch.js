@@ -0,0 +1,68 @@
+//Batched store notifications.
+//
+//Every dispatch notifies each subscriber: connected components, redux-persist and the app data
+//storage. Action creators that change the state in several steps (update the entity tables,
+//then the reports, then the selected report) would render and schedule persistence once per
+//step. batch(thunk) runs a thunk with notifications held back, subscribers are notified once
+//when the outermost batch ends if anything was dispatched meanwhile:
+//  dispatch(batch((dispatch, getState) => {...}))
+//Only the synchronous part of the thunk is batched, dispatches after an await are not.
+
+let depth = 0;
+let pending = [];       //notify functions of stores dispatched to during the batch
+
+const endBatch = () => {
+    depth--;
+    if (depth !== 0) {
+        return;
+    }
+    let notifyList = pending;
+    pending = [];
+    notifyList.forEach((notify) => notify());
+};
+
+//Store enhancer, use it inside applyMiddleware so every subscriber goes through it
+export const batchedSubscribe = (createStore) => (reducer, preloadedState, enhancer) => {
+    let store = createStore(reducer, preloadedState, enhancer);
+    let listeners = [];
+
+    const notify = () => {
+        listeners.slice().forEach((listener) => listener());
+    };
+
+    store.subscribe(() => {
+        if (depth === 0) {
+            notify();
+        } else if (pending.indexOf(notify) === -1) {
+            pending.push(notify);
+        }
+    });
+
+    const subscribe = (listener) => {
+        let isSubscribed = true;
+        listeners.push(listener);
+        return () => {
+            if (!isSubscribed) {
+                return;
+            }
+            isSubscribed = false;
+            listeners.splice(listeners.indexOf(listener), 1);
+        };
+    };
+
+    return {
+        ...store,
+        subscribe: subscribe,
+    };
+};
+
+export const batch = (thunk) => {
+    return (dispatch, getState) => {
+        depth++;
+        try {
+            return thunk(dispatch, getState);
+        } finally {
+            endBatch();
+        }
+    };
+};
@@ -0,0 +1,130 @@
+//Compact encoding of JSON values for storage.
+//
+//Our documents repeat the same keys (report_subsection_id, isLocal, original, ...) and many
+//string values (organization ids, S3 URLs, timestamps) in every record. A document is stored as
+//  ["cj1", [key, ...], [string, ...], body]
+//with every object key replaced by its index in the key list and every string of
+//STRING_MIN_LENGTH or more that occurs twice replaced by a reference into the string list:
+//  object      [keyIndex, value, keyIndex, value, ...]
+//  array       [-1, item, item, ...]
+//  string ref  "~<index in base 36>", a string that starts with "~" gets one more "~"
+//Numbers, booleans and null are unchanged. The result is still JSON text, so it goes through
+//the native JSON.parse and fits AsyncStorage, which only stores strings.
+//
+//Decoding walks the parsed document once more and takes two to three times as long as JSON.parse
+//of the plain text (__tests__/benchmarks/compactJson), so app data shards are no longer written
+//in it. decode still reads the ones written before.
+
+const FORMAT = 'cj1';
+const STRING_MIN_LENGTH = 6;
+const TILDE = 126;
+
+const countStrings = (value, counts) => {
+    if (typeof value === 'string') {
+        if (value.length >= STRING_MIN_LENGTH) {
+            counts.set(value, (counts.get(value) || 0) + 1);
+        }
+    } else if (Array.isArray(value)) {
+        for (let i = 0; i < value.length; i++) {
+            countStrings(value[i], counts);
+        }
+    } else if (value !== null && typeof value === 'object') {
+        for (let key in value) {
+            countStrings(value[key], counts);
+        }
+    }
+};
+
+export const encode = (value) => {
+    let keys = [];
+    let keyIndex = new Map();
+    let strings = [];
+    let stringIndex = new Map();
+
+    let counts = new Map();
+    countStrings(value, counts);
+    counts.forEach((count, string) => {
+        if (count > 1) {
+            stringIndex.set(string, strings.length);
+            strings.push(string);
+        }
+    });
+
+    const encodeValue = (item) => {
+        if (typeof item === 'string') {
+            let index = stringIndex.get(item);
+            if (index !== undefined) {
+                return '~' + index.toString(36);
+            }
+            return (item.charCodeAt(0) === TILDE) ? '~' + item : item;
+        }
+        if (Array.isArray(item)) {
+            let result = [-1];
+            for (let i = 0; i < item.length; i++) {
+                //JSON.stringify writes holes and undefined entries of arrays as null
+                result.push((item[i] === undefined) ? null : encodeValue(item[i]));
+            }
+            return result;
+        }
+        if (item !== null && typeof item === 'object') {
+            if (typeof item.toJSON === 'function') {
+                return encodeValue(item.toJSON());
+            }
+            let result = [];
+            for (let key in item) {
+                let field = item[key];
+                if (field === undefined || typeof field === 'function') {
+                    continue;
+                }
+                let index = keyIndex.get(key);
+                if (index === undefined) {
+                    index = keys.length;
+                    keys.push(key);
+                    keyIndex.set(key, index);
+                }
+                result.push(index, encodeValue(field));
+            }
+            return result;
+        }
+        return item;
+    };
+
+    let body = encodeValue(value);
+    return JSON.stringify([FORMAT, keys, strings, body]);
+};
+
+//Decodes text written by encode, plain JSON is parsed as is
+export const decode = (text) => {
+    let document = JSON.parse(text);
+    if (!Array.isArray(document) || document[0] !== FORMAT || document.length !== 4) {
+        return document;
+    }
+    let keys = document[1];
+    let strings = document[2];
+
+    const decodeValue = (item) => {
+        if (typeof item === 'string') {
+            if (item.charCodeAt(0) !== TILDE) {
+                return item;
+            }
+            return (item.charCodeAt(1) === TILDE) ? item.slice(1) : strings[parseInt(item.slice(1), 36)];
+        }
+        if (Array.isArray(item)) {
+            if (item[0] === -1) {
+                let list = new Array(item.length - 1);
+                for (let i = 1; i < item.length; i++) {
+                    list[i - 1] = decodeValue(item[i]);
+                }
+                return list;
+            }
+            let result = {};
+            for (let i = 0; i < item.length; i += 2) {
+                result[keys[item[i]]] = decodeValue(item[i + 1]);
+            }
+            return result;
+        }
+        return item;
+    };
+
+    return decodeValue(document[3]);
+};
@@ -0,0 +1,51 @@
+import pako from 'pako';
+import Constant from '../helper/constant';
+
+//gzip of request bodies.
+//
+//The text is fed to the compressor compressChunkSize characters at a time and the JS thread is
+//given back between chunks, so a large sync batch does not hold up touches and animations.
+//The bytes are sent as base64 through react-native-fetch-blob, see services/apiCall.
+
+const BASE64 = 'ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/';
+
+const isHighSurrogate = (code) => code >= 0xD800 && code <= 0xDBFF;
+
+//Resolves with the gzip bytes (Uint8Array) of `text` encoded as UTF-8
+export const gzipText = (text) => {
+    return new Promise((resolve, reject) => {
+        let deflate = new pako.Deflate({gzip: true});
+        let offset = 0;
+
+        const step = () => {
+            let end = Math.min(offset + Constant.compressChunkSize, text.length);
+            //a surrogate pair is encoded as one character, it is not split between chunks
+            if (end < text.length && isHighSurrogate(text.charCodeAt(end - 1))) {
+                end--;
+            }
+            let isLast = end === text.length;
+            deflate.push(text.slice(offset, end), isLast);
+            offset = end;
+
+            if (deflate.err) {
+                reject(new Error(deflate.msg || 'gzip failed'));
+            } else if (isLast) {
+                resolve(deflate.result);
+            } else {
+                setTimeout(step, 0);
+            }
+        };
+        step();
+    });
+};
+
+export const toBase64 = (bytes) => {
+    let result = '';
+    for (let i = 0; i < bytes.length; i += 3) {
+        let n = (bytes[i] << 16) | ((bytes[i + 1] || 0) << 8) | (bytes[i + 2] || 0);
+        result += BASE64[(n >> 18) & 63] + BASE64[(n >> 12) & 63] +
+            ((i + 1 < bytes.length) ? BASE64[(n >> 6) & 63] : '=') +
+            ((i + 2 < bytes.length) ? BASE64[n & 63] : '=');
+    }
+    return result;
+};
@@ -0,0 +1,279 @@
+//Normalized tables of the application data.
+//
+//appAllData keeps every report as one nested object (report -> data.subsection_<id> -> images,
+//videos, filedata). The same data is kept here split into entity tables keyed by id, with
+//ordered relationship indexes, so a lookup or a point update touches only one entity:
+//  reports                 report_id -> report fields, `data` left out
+//  subsectionData          <report_id>_subsection_<id> -> subsection fields, media left out
+//  images, videos          media key -> media record
+//  comments                comment id -> comment
+//  reportPosition          report_id -> index in appAllData.reports
+//  subsectionsByReport     report_id -> [subsection_<id>]
+//  imagesBySubsection      subsectionData key -> [media key]
+//  videosBySubsection      subsectionData key -> [media key]
+//  commentsBySubsection    subsection_<id> -> [comment id]
+//  sources                 report_id -> nested report the entities currently describe
+//  templates               template_id -> compiled template, see services/templateIndex
+//Every function returns a new entities object and copies only the tables it changes.
+
+const MEDIA_KINDS = ['images', 'videos'];
+const MEDIA_INDEXES = {
+    images: 'imagesBySubsection',
+    videos: 'videosBySubsection'
+};
+
+let localMediaSeq = 0;
+
+export const createEntities = () => {
+    return {
+        reports: {},
+        subsectionData: {},
+        images: {},
+        videos: {},
+        comments: {},
+        reportPosition: {},
+        subsectionsByReport: {},
+        imagesBySubsection: {},
+        videosBySubsection: {},
+        commentsBySubsection: {},
+        sources: {},
+        templates: {}
+    };
+};
+
+export const getSubsectionKey = (report_id, dataKey) => {
+    return report_id + "_" + dataKey;
+};
+
+//Media ids are unique once the server has seen them, local ones are timestamps and may repeat
+const getMediaKey = (table, media) => {
+    if (media && media.id !== undefined && !table.hasOwnProperty(media.id)) {
+        return String(media.id);
+    }
+    localMediaSeq++;
+    return "local_" + localMediaSeq;
+};
+
+//Copies the named tables once, so a batch of changes to the same table allocates one copy
+const makeWriter = (entities) => {
+    let next = Object.assign({}, entities);
+    let copied = {};
+    return {
+        entities: next,
+        table: (name) => {
+            if (!copied[name]) {
+                next[name] = Object.assign({}, next[name]);
+                copied[name] = true;
+            }
+            return next[name];
+        }
+    };
+};
+
+const removeSubsection = (writer, subsectionKey) => {
+    let entities = writer.entities;
+    MEDIA_KINDS.forEach((kind) => {
+        let keys = entities[MEDIA_INDEXES[kind]][subsectionKey];
+        if (keys !== undefined) {
+            let table = writer.table(kind);
+            keys.forEach((key) => {
+                delete table[key];
+            });
+            delete writer.table(MEDIA_INDEXES[kind])[subsectionKey];
+        }
+    });
+    if (entities.subsectionData.hasOwnProperty(subsectionKey)) {
+        delete writer.table('subsectionData')[subsectionKey];
+    }
+};
+
+const addSubsection = (writer, subsectionKey, subsection) => {
+    let fields = Object.assign({}, subsection);
+    MEDIA_KINDS.forEach((kind) => {
+        if (subsection[kind] === undefined) {
+            return;
+        }
+        delete fields[kind];
+        let table = writer.table(kind);
+        let keys = subsection[kind].map((media) => {
+            let key = getMediaKey(table, media);
+            table[key] = media;
+            return key;
+        });
+        writer.table(MEDIA_INDEXES[kind])[subsectionKey] = keys;
+    });
+    writer.table('subsectionData')[subsectionKey] = fields;
+};
+
+const removeReport = (writer, report_id) => {
+    (writer.entities.subsectionsByReport[report_id] || []).forEach((dataKey) => {
+        removeSubsection(writer, getSubsectionKey(report_id, dataKey));
+    });
+    delete writer.table('subsectionsByReport')[report_id];
+    delete writer.table('reports')[report_id];
+    delete writer.table('sources')[report_id];
+};
+
+const addReport = (writer, report) => {
+    let report_id = report.report_id;
+    let data = report.data;
+    let fields = Object.assign({}, report);
+
+    //an empty `data` comes from the server as an array, it is kept as is
+    if (data && data.length === undefined) {
+        delete fields.data;
+    }
+    let dataKeys = (data && data.length === undefined) ? Object.keys(data) : [];
+    dataKeys.forEach((dataKey) => {
+        addSubsection(writer, getSubsectionKey(report_id, dataKey), data[dataKey]);
+    });
+
+    writer.table('subsectionsByReport')[report_id] = dataKeys;
+    writer.table('reports')[report_id] = fields;
+    writer.table('sources')[report_id] = report;
+};
+
+//Brings the tables in line with a full reports array. Reports identical to the ones the tables
+//were built from are skipped, so replacing one report in the array rebuilds only that report.
+export const normalizeReports = (entities, reports) => {
+    let writer = makeWriter(entities);
+    let position = {};
+    let sources = entities.sources;
+
+    (reports || []).forEach((report, index) => {
+        if (!report) {
+            return;
+        }
+        position[report.report_id] = index;
+        if (sources[report.report_id] !== report) {
+            removeReport(writer, report.report_id);
+            addReport(writer, report);
+        }
+    });
+
+    Object.keys(sources).forEach((report_id) => {
+        if (!position.hasOwnProperty(report_id)) {
+            removeReport(writer, report_id);
+        }
+    });
+
+    writer.entities.reportPosition = position;
+    return writer.entities;
+};
+
+export const normalizeComments = (entities, comments) => {
+    let table = {};
+    let index = {};
+
+    Object.keys(comments || {}).forEach((key) => {
+        index[key] = (comments[key] || []).map((comment) => {
+            table[comment.id] = comment;
+            return comment.id;
+        });
+    });
+    return Object.assign({}, entities, {comments: table, commentsBySubsection: index});
+};
+
+//Merges top level fields (property, agent, inspection_date_time, ...) into a report
+export const setReportFields = (entities, report_id, fields) => {
+    if (!entities.reports.hasOwnProperty(report_id)) {
+        return entities;
+    }
+    let writer = makeWriter(entities);
+    writer.table('reports')[report_id] = Object.assign({}, entities.reports[report_id], fields);
+    return writer.entities;
+};
+
+//Replaces one subsection of a report, including its media
+export const setSubsection = (entities, report_id, dataKey, subsection) => {
+    if (!entities.reports.hasOwnProperty(report_id)) {
+        return entities;
+    }
+    let writer = makeWriter(entities);
+    let subsectionKey = getSubsectionKey(report_id, dataKey);
+    let dataKeys = entities.subsectionsByReport[report_id];
+
+    removeSubsection(writer, subsectionKey);
+    addSubsection(writer, subsectionKey, subsection);
+    if (dataKeys.indexOf(dataKey) === -1) {
+        writer.table('subsectionsByReport')[report_id] = dataKeys.concat([dataKey]);
+    }
+
+    let report = entities.reports[report_id];
+    if (report.data !== undefined) {
+        let fields = Object.assign({}, report);
+        delete fields.data;
+        writer.table('reports')[report_id] = fields;
+    }
+    return writer.entities;
+};
+
+//Inserts (index undefined), replaces (media given) or removes (media undefined) one media record
+//of a subsection, `kind` is 'images' or 'videos'
+export const setMedia = (entities, report_id, dataKey, kind, index, media) => {
+    let subsectionKey = getSubsectionKey(report_id, dataKey);
+    let indexName = MEDIA_INDEXES[kind];
+    let keys = entities[indexName][subsectionKey] || [];
+    if (!entities.reports.hasOwnProperty(report_id) || (index !== undefined && keys.length === 0)) {
+        return entities;
+    }
+
+    //the first media record of a subsection that has none yet creates it
+    let writer = makeWriter(entities);
+    if (!entities.subsectionData.hasOwnProperty(subsectionKey)) {
+        writer = makeWriter(setSubsection(entities, report_id, dataKey, {}));
+    }
+    let table = writer.table(kind);
+    let nextKeys = keys.slice();
+
+    if (index === undefined) {
+        let key = getMediaKey(table, media);
+        table[key] = media;
+        nextKeys.push(key);
+    } else if (index >= 0 && index < keys.length) {
+        if (media === undefined) {
+            delete table[keys[index]];
+            nextKeys.splice(index, 1);
+        } else {
+            table[keys[index]] = media;
+        }
+    } else {
+        return entities;
+    }
+
+    writer.table(indexName)[subsectionKey] = nextKeys;
+    return writer.entities;
+};
+
+export const getReportEntity = (entities, report_id) => {
+    return entities.reports[report_id];
+};
+
+export const getSubsectionEntity = (entities, report_id, dataKey) => {
+    return entities.subsectionData[getSubsectionKey(report_id, dataKey)];
+};
+
+//Nested report as appAllData holds it, rebuilt from the tables
+export const denormalizeReport = (entities, report_id) => {
+    let fields = entities.reports[report_id];
+    if (fields === undefined) {
+        return undefined;
+    }
+    if (fields.data !== undefined) {
+        return Object.assign({}, fields);
+    }
+
+    let data = {};
+    entities.subsectionsByReport[report_id].forEach((dataKey) => {
+        let subsectionKey = getSubsectionKey(report_id, dataKey);
+        let subsection = Object.assign({}, entities.subsectionData[subsectionKey]);
+        MEDIA_KINDS.forEach((kind) => {
+            let keys = entities[MEDIA_INDEXES[kind]][subsectionKey];
+            if (keys !== undefined) {
+                subsection[kind] = keys.map((key) => entities[kind][key]);
+            }
+        });
+        data[dataKey] = subsection;
+    });
+    return Object.assign({}, fields, {data: data});
+};
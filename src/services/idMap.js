@@ -0,0 +1,143 @@
+import {
+    AsyncStorage
+} from 'react-native';
+import { setIn } from './immutable';
+
+//Table of server ids assigned to entities created offline.
+//
+//An acknowledged INSERT only adds a row here. Queued operations keep their local ids and are
+//resolved when they are sent, local copies in the store are replaced when a report is read.
+//Rows are keyed by the local owner of the entity:
+//  report_<report_id>                         report
+//  property|agent|client_<report_id>          one per report
+//  formData_<report_id>_<subsection_id>       one per report subsection
+//  images|videos_<media id>
+//Values are {id} plus the server fields of the entity (image `original`, video `src_url`).
+
+const STORAGE_KEY = 'idMap';
+
+let table = {};
+let loading = null;
+
+const OWNER_RESOURCES = {
+    property: 'property',
+    property_image: 'property',
+    agent: 'agent',
+    agent_image: 'agent',
+    client: 'client',
+    client_image: 'client'
+};
+
+export const getMappingKey = (operation) => {
+    let resource = operation.resource;
+    let localId = (operation.primary_key !== undefined) ? operation.primary_key : operation.id;
+
+    if (OWNER_RESOURCES.hasOwnProperty(resource)) {
+        return OWNER_RESOURCES[resource] + "_" + operation.report_id;
+    }
+    if (resource === 'formData') {
+        return "formData_" + operation.report_id + "_" + operation.data.report_subsection_id;
+    }
+    return resource + "_" + localId;
+};
+
+export const loadIdMap = () => {
+    if (loading === null) {
+        loading = AsyncStorage.getItem(STORAGE_KEY)
+            .then((value) => {
+                table = Object.assign(value ? JSON.parse(value) : {}, table);
+                return table;
+            })
+            .catch((error) => {
+                console.log('id map unreadable', error);
+                return table;
+            });
+    }
+    return loading;
+};
+
+export const getMapping = (key) => {
+    return table[key];
+};
+
+export const setMapping = (key, value) => {
+    table[key] = value;
+
+    let row = {};
+    row[key] = value;
+    return AsyncStorage.mergeItem(STORAGE_KEY, JSON.stringify(row));
+};
+
+export const clearIdMap = () => {
+    table = {};
+    return AsyncStorage.removeItem(STORAGE_KEY);
+};
+
+//Server id of a report, its own id when it was not created offline or is not acknowledged yet
+export const resolveReportId = (reportId) => {
+    let mapping = table["report_" + reportId];
+    return (mapping !== undefined) ? mapping.id : reportId;
+};
+
+//Copy of a queued operation with every id the server has assigned since it was queued.
+//An INSERT of an entity that already has a server id is sent as an UPDATE.
+export const resolveOperation = (operation) => {
+    let resolved = Object.assign({}, operation);
+
+    if (resolved.report_id !== undefined) {
+        resolved.report_id = resolveReportId(resolved.report_id);
+    }
+    if (resolved.data && resolved.data.report_id !== undefined) {
+        resolved.data = Object.assign({}, resolved.data, {report_id: resolveReportId(resolved.data.report_id)});
+    }
+
+    let mapping = table[getMappingKey(operation)];
+    if (mapping !== undefined) {
+        resolved.id = mapping.id;
+        if (resolved.operation === 'INSERT') {
+            resolved.operation = 'UPDATE';
+        }
+    }
+    return resolved;
+};
+
+const resolveEntity = (entity, key) => {
+    let mapping = table[key];
+    if (!entity || mapping === undefined || (entity.id === mapping.id && !entity.isLocal)) {
+        return entity;
+    }
+    let resolved = Object.assign({}, entity, mapping);
+    delete resolved.isLocal;
+    return resolved;
+};
+
+//Report with the server ids of the report and its children. Only the paths to resolved entities
+//are copied, see services/immutable, and the report itself is returned when nothing changed.
+export const resolveReport = (report) => {
+    let localId = report.report_id;
+    let resolved = report;
+
+    let mapping = table["report_" + localId];
+    if (mapping !== undefined) {
+        resolved = Object.assign({}, resolved, {report_id: mapping.id});
+        delete resolved.isLocal;
+    }
+
+    ['property', 'agent', 'client'].forEach((resource) => {
+        resolved = setIn(resolved, [resource], resolveEntity(report[resource], resource + "_" + localId));
+    });
+
+    Object.keys(report.data || {}).forEach((key) => {
+        let subsection = report.data[key];
+        let subsectionId = key.replace("subsection_", "");
+
+        resolved = setIn(resolved, ['data', key, 'filedata'],
+            resolveEntity(subsection.filedata, "formData_" + localId + "_" + subsectionId));
+        ['images', 'videos'].forEach((kind) => {
+            (subsection[kind] || []).forEach((media, index) => {
+                resolved = setIn(resolved, ['data', key, kind, index], resolveEntity(media, kind + "_" + media.id));
+            });
+        });
+    });
+    return resolved;
+};
@@ -0,0 +1,50 @@
+//Immutable updates with structural sharing.
+//
+//Only the objects and arrays on the path to the changed value are copied, everything beside the
+//path is shared with the previous state, so an update costs the depth of the path rather than
+//the size of the tree. Paths are arrays of keys, numbers index into arrays:
+//  setIn(report, ['data', 'subsection_12', 'images', 0], image)
+
+const copyNode = (node, key) => {
+    if (Array.isArray(node)) {
+        return node.slice();
+    }
+    if (node !== null && typeof node === 'object') {
+        return Object.assign({}, node);
+    }
+    return (typeof key === 'number') ? [] : {};
+};
+
+export const updateIn = (target, path, updater) => {
+    if (path.length === 0) {
+        return updater(target);
+    }
+    let key = path[0];
+    let child = (target !== null && target !== undefined) ? target[key] : undefined;
+    let nextChild = updateIn(child, path.slice(1), updater);
+    if (nextChild === child) {
+        return target;
+    }
+    let next = copyNode(target, key);
+    next[key] = nextChild;
+    return next;
+};
+
+export const setIn = (target, path, value) => {
+    return updateIn(target, path, () => value);
+};
+
+//Array helpers returning new arrays, the elements themselves are shared
+
+export const pushIn = (target, path, value) => {
+    return updateIn(target, path, (list) => (list || []).concat([value]));
+};
+
+export const removeIn = (target, path, index) => {
+    return updateIn(target, path, (list) => {
+        if (!list || index < 0 || index >= list.length) {
+            return list;
+        }
+        return list.slice(0, index).concat(list.slice(index + 1));
+    });
+};
@@ -0,0 +1,162 @@
+//Incremental JSON reader.
+//
+//Text is fed in chunks with write(). Only values at the selected paths are collected and
+//parsed, one at a time, everything else is scanned and dropped, so memory stays bounded by the
+//largest selected value instead of the whole document. Paths are dot separated keys, `[]`
+//stands for every element of an array:
+//  createJsonStream({'reports[]': true, 'cursor': true}, (path, value) => {...})
+//calls back once per report and once with the cursor.
+
+const isWhitespace = (c) => c === ' ' || c === '\n' || c === '\r' || c === '\t';
+
+export const createJsonStream = (selectors, onValue) => {
+    let stack = [];             //{isArray, path, key, state: 'key' | 'colon' | 'value' | 'comma'}
+    let inString = false;
+    let isEscaped = false;
+    let isKey = false;
+    let keyChars = "";
+    let capture = null;         //{path, depth, kind: 'container' | 'string' | 'primitive', parts}
+    let chunk = "";
+    let captureStart = 0;
+
+    const getValuePath = () => {
+        let parent = stack[stack.length - 1];
+        if (parent === undefined) {
+            return "";
+        }
+        if (parent.isArray) {
+            return parent.path + "[]";
+        }
+        return (parent.path !== "") ? parent.path + "." + parent.key : parent.key;
+    };
+
+    const finishCapture = (end) => {
+        capture.parts.push(chunk.slice(captureStart, end));
+        let path = capture.path;
+        let text = capture.parts.join("");
+        capture = null;
+        onValue(path, JSON.parse(text));
+    };
+
+    const valueDone = () => {
+        let top = stack[stack.length - 1];
+        if (top !== undefined) {
+            top.state = 'comma';
+        }
+    };
+
+    const closeContainer = (index) => {
+        stack.pop();
+        if (capture !== null && capture.kind === 'container' && stack.length === capture.depth) {
+            finishCapture(index + 1);
+        }
+        valueDone();
+    };
+
+    const beginValue = (c, index) => {
+        let path = getValuePath();
+
+        if (capture === null && selectors[path]) {
+            let kind = (c === '{' || c === '[') ? 'container' : (c === '"') ? 'string' : 'primitive';
+            capture = {path: path, depth: stack.length, kind: kind, parts: []};
+            captureStart = index;
+        }
+
+        if (c === '{') {
+            stack.push({isArray: false, path: path, key: null, state: 'key'});
+        } else if (c === '[') {
+            stack.push({isArray: true, path: path, key: null, state: 'value'});
+        } else if (c === '"') {
+            inString = true;
+            isKey = false;
+        } else {
+            valueDone();
+        }
+    };
+
+    const write = (text) => {
+        chunk = text;
+        captureStart = 0;
+
+        for (let i = 0; i < chunk.length; i++) {
+            let c = chunk[i];
+
+            if (inString) {
+                if (isEscaped) {
+                    isEscaped = false;
+                } else if (c === '\\') {
+                    isEscaped = true;
+                } else if (c === '"') {
+                    inString = false;
+                    if (isKey) {
+                        let top = stack[stack.length - 1];
+                        top.key = keyChars;
+                        top.state = 'colon';
+                    } else {
+                        if (capture !== null && capture.kind === 'string' && stack.length === capture.depth) {
+                            finishCapture(i + 1);
+                        }
+                        valueDone();
+                    }
+                    continue;
+                }
+                if (isKey && capture === null) {
+                    keyChars += c;
+                }
+                continue;
+            }
+
+            if (capture !== null && capture.kind === 'primitive' &&
+                (c === ',' || c === '}' || c === ']' || isWhitespace(c))) {
+                finishCapture(i);
+            }
+            if (isWhitespace(c)) {
+                continue;
+            }
+
+            let top = stack[stack.length - 1];
+            if (top === undefined) {
+                beginValue(c, i);
+            } else if (top.state === 'key') {
+                if (c === '"') {
+                    inString = true;
+                    isKey = true;
+                    keyChars = "";
+                } else if (c === '}') {
+                    closeContainer(i);
+                }
+            } else if (top.state === 'colon') {
+                if (c === ':') {
+                    top.state = 'value';
+                }
+            } else if (top.state === 'comma') {
+                if (c === ',') {
+                    top.state = top.isArray ? 'value' : 'key';
+                } else if (c === '}' || c === ']') {
+                    closeContainer(i);
+                }
+            } else if (top.isArray && c === ']') {
+                closeContainer(i);
+            } else {
+                beginValue(c, i);
+            }
+        }
+
+        if (capture !== null) {
+            capture.parts.push(chunk.slice(captureStart));
+        }
+        chunk = "";
+    };
+
+    //A primitive selected at the very end of the input has no delimiter after it
+    const end = () => {
+        if (capture !== null && capture.kind === 'primitive') {
+            finishCapture(0);
+        }
+    };
+
+    return {
+        write: write,
+        end: end
+    };
+};
@@ -0,0 +1,30 @@
+import { RNS3 } from 'react-native-aws3';
+import RNFS from 'react-native-fs';
+import Constant from '../helper/constant';
+import {
+    schedule,
+    PRIORITY_TRANSFER
+} from './requestScheduler';
+
+//Media uploads and downloads, run in the transfer class of services/requestScheduler so they
+//wait for the requests a screen needs
+
+//RNS3.put scheduled, `onProgress` gets the upload progress events. Uploads go to
+//Constant.mediaHost when it is set.
+export const putMedia = (file, options, onProgress) => {
+    if (Constant.mediaHost) {
+        options = Object.assign({}, options, {awsUrl: Constant.mediaHost});
+    }
+    return schedule(PRIORITY_TRANSFER, () => {
+        let upload = RNS3.put(file, options);
+        if (onProgress) {
+            upload.progress(onProgress);
+        }
+        return upload;
+    });
+};
+
+//RNFS.downloadFile scheduled, resolves with the download result
+export const downloadMedia = (options) => {
+    return schedule(PRIORITY_TRANSFER, () => RNFS.downloadFile(options).promise);
+};
@@ -0,0 +1,98 @@
+import Constant from '../helper/constant';
+
+//Orders network work by priority class.
+//  interactive     requests a screen is waiting for, the default of CallApi
+//  background      sync posts and data exports
+//  transfer        media uploads and downloads
+//Each class runs at most requestLimits[class] tasks at once. Background and transfer tasks do not
+//start while interactive requests are queued or in flight, so a screen fetch does not queue
+//behind a sync batch or a video upload. Running tasks are not cancelled, a started upload is
+//left to finish, and lower classes start anyway once interactive requests have kept them waiting
+//for requestYieldMax ms so they are not starved.
+
+export const PRIORITY_INTERACTIVE = 'interactive';
+export const PRIORITY_BACKGROUND = 'background';
+export const PRIORITY_TRANSFER = 'transfer';
+
+const PRIORITIES = [PRIORITY_INTERACTIVE, PRIORITY_BACKGROUND, PRIORITY_TRANSFER];
+
+let queues = {};
+let running = {};
+PRIORITIES.forEach((priority) => {
+    queues[priority] = [];
+    running[priority] = 0;
+});
+let waitingSince = null;    //since when lower classes have been held back
+let yieldTimer = null;
+
+const isInteractiveBusy = () => {
+    return queues[PRIORITY_INTERACTIVE].length !== 0 || running[PRIORITY_INTERACTIVE] !== 0;
+};
+
+const canStart = (priority) => {
+    if (running[priority] >= Constant.requestLimits[priority]) {
+        return false;
+    }
+    if (priority === PRIORITY_INTERACTIVE || !isInteractiveBusy()) {
+        return true;
+    }
+    return waitingSince !== null && Date.now() - waitingSince >= Constant.requestYieldMax;
+};
+
+const start = (priority, job) => {
+    running[priority]++;
+    const finish = () => {
+        running[priority]--;
+        pump();
+    };
+
+    let result;
+    try {
+        result = Promise.resolve(job.task());
+    } catch (error) {
+        result = Promise.reject(error);
+    }
+    result.then(finish, finish);
+    result.then(job.resolve, job.reject);
+};
+
+const pump = () => {
+    PRIORITIES.forEach((priority) => {
+        while (queues[priority].length !== 0 && canStart(priority)) {
+            start(priority, queues[priority].shift());
+        }
+    });
+
+    let isHeldBack = isInteractiveBusy() &&
+        (queues[PRIORITY_BACKGROUND].length !== 0 || queues[PRIORITY_TRANSFER].length !== 0);
+    if (!isHeldBack) {
+        waitingSince = null;
+        if (yieldTimer !== null) {
+            clearTimeout(yieldTimer);
+            yieldTimer = null;
+        }
+    } else {
+        if (waitingSince === null) {
+            waitingSince = Date.now();
+        }
+        //a timer may fire a little early, the rest of the wait is scheduled again
+        let remaining = Constant.requestYieldMax - (Date.now() - waitingSince);
+        if (yieldTimer === null && remaining > 0) {
+            yieldTimer = setTimeout(() => {
+                yieldTimer = null;
+                pump();
+            }, remaining);
+        }
+    }
+};
+
+//Runs `task` (() => Promise) when its class may start, resolves or rejects as the task does
+export const schedule = (priority, task) => {
+    if (queues[priority] === undefined) {
+        priority = PRIORITY_INTERACTIVE;
+    }
+    return new Promise((resolve, reject) => {
+        queues[priority].push({task: task, resolve: resolve, reject: reject});
+        pump();
+    });
+};
@@ -0,0 +1,72 @@
+import Constant from '../helper/constant';
+
+//Error classes and retries of single requests.
+//  network     no response, the request may or may not have reached the server
+//  server      5xx and 429, the server may succeed on a later attempt
+//  conflict    409, the resource or the idempotency key is in use by another attempt. It clears
+//              by itself, the caller sends again later instead of repeating at once
+//  auth        401, the token is renewed by CallAuthApi, see services/authSession
+//  client      any other 4xx, the request itself is wrong
+//Only network and server errors are retried, and only for requests that are safe to repeat: GET,
+//PUT, DELETE, and POST with an idempotency key. A key lets the server answer a repeated POST
+//with the result of the first one, so a response lost after the server committed does not
+//create the rows twice.
+
+export const ERROR_NETWORK = 'network';
+export const ERROR_SERVER = 'server';
+export const ERROR_CONFLICT = 'conflict';
+export const ERROR_AUTH = 'auth';
+export const ERROR_CLIENT = 'client';
+
+export const classifyError = (err) => {
+    let response = err && err.response;
+    if (!response) {
+        return ERROR_NETWORK;
+    }
+    let status = (response.data && response.data.status_code) || response.status;
+    if (status === 401) {
+        return ERROR_AUTH;
+    }
+    if (status === 409) {
+        return ERROR_CONFLICT;
+    }
+    if (status === 429 || status >= 500) {
+        return ERROR_SERVER;
+    }
+    return ERROR_CLIENT;
+};
+
+export const isRetryable = (err) => {
+    let errorClass = classifyError(err);
+    return errorClass === ERROR_NETWORK || errorClass === ERROR_SERVER;
+};
+
+//Exponential backoff with full jitter
+const getRetryDelay = (attempt) => {
+    let delay = Math.min(Constant.requestRetryMax, Constant.requestRetryBase * Math.pow(2, attempt));
+    return Math.round(Math.random() * delay);
+};
+
+//Runs `send` (() => Promise) again after retryable errors, at most requestRetries more times
+export const withRetry = (send) => {
+    const attempt = (count) => {
+        return send().catch((err) => {
+            if (count >= Constant.requestRetries || !isRetryable(err)) {
+                return Promise.reject(err);
+            }
+            return new Promise((resolve) => setTimeout(resolve, getRetryDelay(count)))
+                .then(() => attempt(count + 1));
+        });
+    };
+    return attempt(0);
+};
+
+//Short stable key for a list of operation ids, the same batch gets the same key on every attempt
+export const getIdempotencyKey = (prefix, ids) => {
+    let text = ids.join(',');
+    let hash = 5381;
+    for (let i = 0; i < text.length; i++) {
+        hash = ((hash * 33) ^ text.charCodeAt(i)) >>> 0;
+    }
+    return prefix + '-' + ids.length + '-' + ids[0] + '-' + hash.toString(16);
+};
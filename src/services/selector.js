@@ -0,0 +1,67 @@
+//Memoized selectors for derived store data.
+//
+//  createSelector(inputA, inputB, (a, b) => result)
+//returns (state, arg) => result. Inputs are called with the same arguments as the selector, the
+//result is computed again only when one of the input values changed by identity, so a screen
+//connected through selectors receives the same props object and skips its render. Every
+//selector caches one set of inputs, screens that select with their own arguments (a subsection
+//id from navigation params) create an instance per component with a make... factory.
+
+export const createSelector = (...funcs) => {
+    let combiner = funcs.pop();
+    let lastInputs = null;
+    let lastResult;
+
+    return (state, arg) => {
+        let inputs = funcs.map((func) => func(state, arg));
+        if (lastInputs !== null && inputs.every((value, index) => value === lastInputs[index])) {
+            return lastResult;
+        }
+        lastInputs = inputs;
+        lastResult = combiner(...inputs);
+        return lastResult;
+    };
+};
+
+export const shallowEqual = (a, b) => {
+    if (a === b) {
+        return true;
+    }
+    if (!a || !b) {
+        return false;
+    }
+    let keys = Object.keys(a);
+    if (keys.length !== Object.keys(b).length) {
+        return false;
+    }
+    return keys.every((key) => b.hasOwnProperty(key) && a[key] === b[key]);
+};
+
+//Keeps the previous list, and the previous items, when a recomputed list has the same content,
+//for derived lists that are rebuilt from a source that changes more often than they do
+export const createListCache = (getKey) => {
+    let lastList = [];
+    let lastItems = {};
+
+    return (list) => {
+        let items = {};
+        let isSame = list.length === lastList.length;
+
+        let next = list.map((item, index) => {
+            let key = getKey(item);
+            let previous = lastItems[key];
+            if (shallowEqual(previous, item)) {
+                item = previous;
+            }
+            items[key] = item;
+            isSame = isSame && lastList[index] === item;
+            return item;
+        });
+
+        lastItems = items;
+        if (!isSame) {
+            lastList = next;
+        }
+        return lastList;
+    };
+};
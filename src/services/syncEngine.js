@@ -0,0 +1,143 @@
+import {
+    NetInfo,
+    AppState
+} from 'react-native';
+import BackgroundTimer from 'react-native-background-timer';
+import Constant from '../helper/constant';
+import {
+    recordRetry,
+    recordReconnect,
+    flushTelemetry
+} from './syncTelemetry';
+
+//Drains the offline sync queue when there is something to do: an operation is enqueued, the
+//device comes back online or the app returns to the foreground. Every batch is sent on its own
+//and its slot is refilled as soon as it is answered, a slow report does not hold back the others.
+//A batch that fails, or that the server answers without acknowledging all of its operations, is
+//retried with exponential backoff and full jitter. Nothing is scheduled while the queue is idle.
+
+let drainQueue = null;      //(isRetry) => Promise of the batches started, each resolves true when all of its operations were acknowledged
+let isConnected = false;
+let isDraining = false;
+let isWakeRequested = false;
+let isRetryRequested = false;
+let retryTimer = null;
+let failures = 0;
+
+const clearRetry = () => {
+    if (retryTimer !== null) {
+        BackgroundTimer.clearTimeout(retryTimer);
+        retryTimer = null;
+    }
+};
+
+const scheduleRetry = () => {
+    let delay = Math.min(Constant.syncRetryMax, Constant.syncRetryBase * Math.pow(2, failures - 1));
+    clearRetry();
+    retryTimer = BackgroundTimer.setTimeout(() => {
+        retryTimer = null;
+        recordRetry();
+        wakeSyncEngine(true);
+    }, Math.round(Math.random() * delay));
+};
+
+const onFailure = (error) => {
+    failures++;
+    console.log('sync failed', error);
+    scheduleRetry();
+};
+
+//The batch's slot is free, refill it. Operations that were not acknowledged wait for the retry.
+const onBatchAnswered = (isAcknowledged) => {
+    if (!isAcknowledged) {
+        onFailure('operations not acknowledged');
+    } else if (retryTimer === null) {
+        failures = 0;
+    }
+    wakeSyncEngine();
+};
+
+const onBatchFailed = (error) => {
+    onFailure(error);
+    wakeSyncEngine();
+};
+
+const drain = (isRetry) => {
+    isDraining = true;
+    isWakeRequested = false;
+    isRetryRequested = false;
+
+    drainQueue(isRetry)
+        .then((batches) => {
+            isDraining = false;
+            batches.forEach((batch) => {
+                batch.then(onBatchAnswered, onBatchFailed);
+            });
+            if (isWakeRequested) {
+                wakeSyncEngine(isRetryRequested);
+            }
+        })
+        .catch((error) => {
+            isDraining = false;
+            onFailure(error);
+        });
+};
+
+const onConnectionChange = (connected) => {
+    isConnected = connected;
+    if (connected) {
+        failures = 0;
+        recordReconnect();
+        wakeSyncEngine(true);
+    } else {
+        clearRetry();
+    }
+};
+
+const onAppStateChange = (state) => {
+    if (state === 'active') {
+        wakeSyncEngine();
+    } else if (state === 'background') {
+        flushTelemetry();
+    }
+};
+
+//`isRetry` also sends the operations held back after failures, a pending retry is not cancelled
+//by ordinary wakes
+export const wakeSyncEngine = (isRetry = false) => {
+    if (drainQueue === null || !isConnected) {
+        return;
+    }
+    if (isDraining) {
+        isWakeRequested = true;
+        isRetryRequested = isRetryRequested || isRetry;
+        return;
+    }
+    if (isRetry) {
+        clearRetry();
+    }
+    drain(isRetry);
+};
+
+export const startSyncEngine = (drainFunc) => {
+    if (drainQueue !== null) {
+        drainQueue = drainFunc;
+        return;
+    }
+    drainQueue = drainFunc;
+
+    NetInfo.isConnected.addEventListener('connectionChange', onConnectionChange);
+    AppState.addEventListener('change', onAppStateChange);
+    NetInfo.isConnected.fetch().then(onConnectionChange);
+};
+
+export const stopSyncEngine = () => {
+    if (drainQueue === null) {
+        return;
+    }
+    drainQueue = null;
+    clearRetry();
+
+    NetInfo.isConnected.removeEventListener('connectionChange', onConnectionChange);
+    AppState.removeEventListener('change', onAppStateChange);
+};
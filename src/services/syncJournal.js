@@ -0,0 +1,164 @@
+import RNFS from 'react-native-fs';
+import Constant from '../helper/constant';
+import {
+    createQueue,
+    getQueueSize,
+    setQueueObserver
+} from './syncQueue';
+
+//Durable storage for the offline sync queue.
+//
+//Every queue mutation is appended as one JSON line to the journal file:
+//  {"s":<seq>,"o":<operation>}   operation stored at seq (enqueue or replace)
+//  {"s":<seq>}                   operation at seq removed
+//Records are idempotent, so replaying the journal over a checkpoint that already contains
+//some of them gives the same queue. A line torn by a crash mid-write fails to parse and is
+//skipped. Once the journal grows past syncJournalMaxRecords, or the queue is drained, the
+//queue is written to a checkpoint file (write to temp + rename) and the journal is truncated.
+//A crash between removing the old checkpoint and renaming the temp file leaves only the temp
+//file, which was completely written by then, so it is read when the checkpoint is missing.
+
+const checkpointPath = RNFS.DocumentDirectoryPath + '/syncQueue.checkpoint';
+const tempPath = checkpointPath + '.tmp';
+const journalPath = RNFS.DocumentDirectoryPath + '/syncQueue.journal';
+
+let queue = createQueue();
+let loading = null;
+let pendingLines = [];
+let journalRecords = 0;
+let writeChain = Promise.resolve();
+
+const readFile = (path) => {
+    return RNFS.exists(path)
+        .then((exists) => exists ? RNFS.readFile(path, 'utf8') : "");
+};
+
+const readCheckpoint = () => {
+    return RNFS.exists(checkpointPath)
+        .then((exists) => exists ? RNFS.readFile(checkpointPath, 'utf8') : readFile(tempPath));
+};
+
+const replay = (checkpoint, journal) => {
+    let restored = createQueue();
+    if (checkpoint !== "") {
+        try {
+            restored = JSON.parse(checkpoint);
+        } catch (e) {
+            console.log('sync checkpoint unreadable', e);
+        }
+    }
+
+    let records = 0;
+    journal.split('\n').forEach((line) => {
+        if (line === "") {
+            return;
+        }
+        let record;
+        try {
+            record = JSON.parse(line);
+        } catch (e) {
+            return;
+        }
+        if (record.hasOwnProperty('o')) {
+            restored.operations[record.s] = record.o;
+        } else {
+            delete restored.operations[record.s];
+        }
+        restored.seq = Math.max(restored.seq, record.s);
+        records++;
+    });
+
+    journalRecords = records;
+    return restored;
+};
+
+const writeCheckpoint = () => {
+    let snapshot = JSON.stringify(queue);
+
+    journalRecords = 0;
+    return RNFS.writeFile(tempPath, snapshot, 'utf8')
+        .then(() => RNFS.exists(checkpointPath))
+        .then((exists) => exists ? RNFS.unlink(checkpointPath) : null)
+        .then(() => RNFS.moveFile(tempPath, checkpointPath))
+        .then(() => RNFS.writeFile(journalPath, "", 'utf8'));
+};
+
+const flush = () => {
+    if (pendingLines.length === 0) {
+        return Promise.resolve();
+    }
+    let lines = pendingLines.join('');
+    pendingLines = [];
+
+    return RNFS.appendFile(journalPath, lines, 'utf8')
+        .then(() => {
+            if (journalRecords >= Constant.syncJournalMaxRecords || getQueueSize(queue) === 0) {
+                return writeCheckpoint();
+            }
+        }, (error) => {
+            //records did not reach the journal, the next flush writes a full checkpoint instead
+            journalRecords = Constant.syncJournalMaxRecords;
+            return Promise.reject(error);
+        });
+};
+
+//Records written in the same tick go to the file in one append, writes never overlap
+const append = (record) => {
+    pendingLines.push(JSON.stringify(record) + '\n');
+    journalRecords++;
+
+    if (pendingLines.length === 1) {
+        writeChain = writeChain
+            .then(flush)
+            .catch((error) => {
+                console.log('sync journal write failed', error);
+            });
+    }
+};
+
+setQueueObserver((seq, operation) => {
+    if (loading === null) {
+        return;
+    }
+    append((operation !== undefined) ? {s: seq, o: operation} : {s: seq});
+});
+
+export const loadSyncJournal = () => {
+    if (loading === null) {
+        loading = Promise.all([readCheckpoint(), readFile(journalPath)])
+            .then(([checkpoint, journal]) => {
+                queue = replay(checkpoint, journal);
+            })
+            .catch((error) => {
+                console.log('sync journal unreadable', error);
+            });
+    }
+    return loading;
+};
+
+export const getSyncQueue = () => {
+    return queue;
+};
+
+export const setSyncQueue = (nextQueue) => {
+    queue = nextQueue;
+};
+
+//Drops every queued operation, used when the user logs out
+export const clearSyncJournal = () => {
+    return loadSyncJournal().then(() => {
+        queue = createQueue();
+        pendingLines = [];
+        writeChain = writeChain
+            .then(writeCheckpoint)
+            .catch((error) => {
+                console.log('sync journal write failed', error);
+            });
+        return writeChain;
+    });
+};
+
+//Waits for every journal record to reach the file
+export const flushSyncJournal = () => {
+    return writeChain;
+};
@@ -0,0 +1,218 @@
+//Offline sync queue.
+//
+//Stored shape is {seq, operations} where `operations` maps a sequence number to the queued
+//operation. Integer keys iterate in ascending order, so the object keeps FIFO order without an
+//array to splice. Lookups by operation_id, entity and report go through an index that is kept
+//in memory only and rebuilt once after loading.
+
+//Fields of a local entity that must not be sent with an INSERT
+const LOCAL_FIELDS = ['id', 'isLocal'];
+
+let indexes = new WeakMap();
+let observer = null;
+
+//Observer is called with (seq, operation) when an operation is stored and (seq) when it is removed
+export const setQueueObserver = (callback) => {
+    observer = callback;
+};
+
+const notify = (seq, operation) => {
+    if (observer !== null) {
+        observer(seq, operation);
+    }
+};
+
+//Key of the local entity an operation is about. DELETE entries carry `id` instead of `primary_key`.
+export const getEntityKey = (operation) => {
+    let key = (operation.primary_key !== undefined) ? operation.primary_key : operation.id;
+    return operation.resource + "_" + key;
+};
+
+//Report an operation belongs to. Operations of different reports never depend on each other.
+export const getReportKey = (operation) => {
+    if (operation.resource === 'report') {
+        return (operation.primary_key !== undefined) ? operation.primary_key : operation.id;
+    }
+    return operation.report_id;
+};
+
+const addToIndex = (index, seq, operation) => {
+    let entityKey = getEntityKey(operation);
+    let reportKey = "" + getReportKey(operation);
+
+    index.ids[operation.operation_id] = seq;
+    index.entities[entityKey] = (index.entities[entityKey] || []).concat(seq);
+    if (!index.reports.hasOwnProperty(reportKey)) {
+        index.reports[reportKey] = {};
+    }
+    index.reports[reportKey][seq] = true;
+};
+
+const removeFromIndex = (index, seq, operation) => {
+    let entityKey = getEntityKey(operation);
+    let reportKey = "" + getReportKey(operation);
+
+    delete index.ids[operation.operation_id];
+    let entity = (index.entities[entityKey] || []).filter((value) => value !== seq);
+    if (entity.length !== 0) {
+        index.entities[entityKey] = entity;
+    } else {
+        delete index.entities[entityKey];
+    }
+    if (index.reports.hasOwnProperty(reportKey)) {
+        delete index.reports[reportKey][seq];
+    }
+};
+
+const getIndex = (queue) => {
+    let index = indexes.get(queue);
+    if (index === undefined) {
+        index = {ids: {}, entities: {}, reports: {}, size: 0};
+        for (let seq in queue.operations) {
+            addToIndex(index, parseInt(seq), queue.operations[seq]);
+            index.size++;
+        }
+        indexes.set(queue, index);
+    }
+    return index;
+};
+
+//Every mutation hands out a new queue object so the store sees a change, the operations
+//table and its index are shared and moved over in O(1).
+const nextQueue = (queue, seq) => {
+    let next = {seq: seq, operations: queue.operations};
+    indexes.set(next, getIndex(queue));
+    indexes.delete(queue);
+    return next;
+};
+
+export const createQueue = () => {
+    return {seq: 0, operations: {}};
+};
+
+export const getQueueSize = (queue) => {
+    return getIndex(queue).size;
+};
+
+//Calls `callback` for every operation in FIFO order, stops when it returns false
+export const forEachOperation = (queue, callback) => {
+    for (let seq in queue.operations) {
+        if (callback(queue.operations[seq]) === false) {
+            break;
+        }
+    }
+};
+
+export const toArray = (queue) => {
+    let result = [];
+    forEachOperation(queue, (operation) => {
+        result.push(operation);
+    });
+    return result;
+};
+
+export const findOperation = (queue, operationId) => {
+    let seq = getIndex(queue).ids[operationId];
+    return (seq !== undefined) ? queue.operations[seq] : undefined;
+};
+
+export const getEntityOperations = (queue, entityKey) => {
+    return (getIndex(queue).entities[entityKey] || []).map((seq) => queue.operations[seq]);
+};
+
+export const getReportOperations = (queue, reportKey) => {
+    let seqs = getIndex(queue).reports["" + reportKey] || {};
+    return Object.keys(seqs).map((seq) => queue.operations[seq]);
+};
+
+export const enqueue = (queue, operation) => {
+    let index = getIndex(queue);
+    let seq = queue.seq + 1;
+
+    queue.operations[seq] = operation;
+    addToIndex(index, seq, operation);
+    index.size++;
+    notify(seq, operation);
+    return nextQueue(queue, seq);
+};
+
+//Replaces an operation keeping its place in the queue
+export const replaceOperation = (queue, operationId, operation) => {
+    let index = getIndex(queue);
+    let seq = index.ids[operationId];
+    if (seq === undefined) {
+        return queue;
+    }
+
+    removeFromIndex(index, seq, queue.operations[seq]);
+    queue.operations[seq] = operation;
+    addToIndex(index, seq, operation);
+    notify(seq, operation);
+    return nextQueue(queue, queue.seq);
+};
+
+export const removeOperation = (queue, operationId) => {
+    let index = getIndex(queue);
+    let seq = index.ids[operationId];
+    if (seq === undefined) {
+        return queue;
+    }
+
+    removeFromIndex(index, seq, queue.operations[seq]);
+    delete queue.operations[seq];
+    index.size--;
+    notify(seq);
+    return nextQueue(queue, queue.seq);
+};
+
+//Compacts the queue with a new operation before it is enqueued:
+// - INSERT followed by DELETE of the same local entity cancel out (for a report, with its children)
+// - DELETE of a never synced (`isLocal`) entity is dropped
+// - UPDATE of a queued INSERT is folded into the INSERT
+// - successive UPDATEs/INSERTs of the same entity keep only the latest one
+//Operations in flight are never touched, the new operation is queued after them instead.
+export const compactOperation = (queue, operation, inFlight = {}) => {
+    let entityOperations = getEntityOperations(queue, getEntityKey(operation));
+    let pending = entityOperations.filter((entry) => !inFlight[entry.operation_id]);
+    let isSending = pending.length !== entityOperations.length;
+
+    if (operation.operation === 'DELETE') {
+        let queuedInsert = pending.some((entry) => entry.operation === 'INSERT');
+        let result = queue;
+
+        pending.forEach((entry) => {
+            result = removeOperation(result, entry.operation_id);
+        });
+
+        if (queuedInsert || (operation.isLocal && !isSending)) {
+            if (operation.resource === 'report') {
+                getReportOperations(result, operation.id).forEach((entry) => {
+                    if (!inFlight[entry.operation_id]) {
+                        result = removeOperation(result, entry.operation_id);
+                    }
+                });
+            }
+            return result;
+        }
+
+        let deleteOperation = Object.assign({}, operation);
+        delete deleteOperation.isLocal;
+        return enqueue(result, deleteOperation);
+    }
+
+    let existing = pending[pending.length - 1];
+
+    if (existing === undefined) {
+        return enqueue(queue, operation);
+    } else if (existing.operation === 'INSERT' && operation.operation === 'UPDATE') {
+        let data = Object.assign({}, existing.data, operation.data);
+        LOCAL_FIELDS.forEach((field) => {
+            delete data[field];
+        });
+        return replaceOperation(queue, existing.operation_id, Object.assign({}, existing, {
+            data: data,
+            record_timestamp: operation.record_timestamp
+        }));
+    }
+    return replaceOperation(queue, existing.operation_id, operation);
+};
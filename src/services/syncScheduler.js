@@ -0,0 +1,77 @@
+import Constant from '../helper/constant';
+import {
+    getEntityKey,
+    getReportKey,
+    getEntityOperations,
+    forEachOperation
+} from './syncQueue';
+
+//Walks the queue in FIFO order and returns the operations whose dependencies are resolved:
+// - no earlier operation on the same entity is still queued or in flight
+// - the parent report is not waiting for its INSERT to be acknowledged
+export const getReadyOperations = (queue, inFlight = {}) => {
+    let seenEntities = {};
+    let ready = [];
+
+    let waitsForParent = (operation) => {
+        if (operation.resource === 'report') {
+            return false;
+        }
+        return getEntityOperations(queue, getEntityKey({resource: 'report', primary_key: operation.report_id}))
+            .some((entry) => entry.operation === 'INSERT');
+    };
+
+    forEachOperation(queue, (operation) => {
+        let entityKey = getEntityKey(operation);
+
+        if (!seenEntities[entityKey] && !inFlight[operation.operation_id] && !waitsForParent(operation)) {
+            ready.push(operation);
+        }
+        seenEntities[entityKey] = true;
+    });
+    return ready;
+};
+
+//Groups ready operations per report and cuts every group into batches limited by
+//syncBatchSize/syncBatchBytes. At most `maxBatches` batches are returned, one per report
+//first so that a large report does not take every slot.
+export const getSyncBatches = (queue, inFlight = {}, maxBatches = Constant.syncMaxInFlight) => {
+    let lanes = {};
+    let laneOrder = [];
+
+    getReadyOperations(queue, inFlight).forEach((operation) => {
+        let reportKey = "" + getReportKey(operation);
+        if (!lanes.hasOwnProperty(reportKey)) {
+            lanes[reportKey] = [];
+            laneOrder.push(reportKey);
+        }
+
+        let batches = lanes[reportKey];
+        let batch = batches[batches.length - 1];
+        let size = JSON.stringify(operation).length;
+
+        if (batch === undefined || batch.operations.length >= Constant.syncBatchSize ||
+            batch.bytes + size > Constant.syncBatchBytes) {
+            batch = {operations: [], bytes: 0};
+            batches.push(batch);
+        }
+        batch.operations.push(operation);
+        batch.bytes += size;
+    });
+
+    let result = [];
+    for (let round = 0; result.length < maxBatches; round++) {
+        let added = false;
+        for (let i = 0; i < laneOrder.length && result.length < maxBatches; i++) {
+            let batch = lanes[laneOrder[i]][round];
+            if (batch !== undefined) {
+                result.push(batch.operations);
+                added = true;
+            }
+        }
+        if (!added) {
+            break;
+        }
+    }
+    return result;
+};
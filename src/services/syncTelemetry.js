@@ -0,0 +1,143 @@
+import { Answers } from 'react-native-fabric';
+import Constant from '../helper/constant';
+
+//Aggregates sync queue metrics on the device and reports them through Crashlytics Answers.
+//Nothing is sent per operation: counters are kept for a window of syncTelemetryWindow ms and
+//emitted as a few custom events when a later record sees the window has passed, or when the
+//app goes to the background.
+//  Sync Summary   enqueue/ack/failure/retry counts, batches, bytes, queue depth
+//  Sync Latency   round trip histogram of one resource
+//  Sync Drain     time and bytes from reconnect to empty queue, sent once per drain
+
+const LATENCY_BUCKETS = [250, 1000, 4000, 16000];
+
+let windowStart = Date.now();
+let summary = null;
+let latency = {};
+let drain = null;
+
+const resetWindow = () => {
+    windowStart = Date.now();
+    summary = {
+        enqueued: 0,
+        acked: 0,
+        failed: 0,
+        retries: 0,
+        batches: 0,
+        bytes: 0,
+        maxDepth: 0,
+        lastDepth: 0
+    };
+    latency = {};
+};
+
+resetWindow();
+
+const getBucketName = (ms) => {
+    for (let i = 0; i < LATENCY_BUCKETS.length; i++) {
+        if (ms < LATENCY_BUCKETS[i]) {
+            return "< " + LATENCY_BUCKETS[i] + " ms";
+        }
+    }
+    return ">= " + LATENCY_BUCKETS[LATENCY_BUCKETS.length - 1] + " ms";
+};
+
+const logEvent = (name, attributes) => {
+    try {
+        Answers.logCustom(name, attributes);
+    } catch (e) {
+        console.log('telemetry not sent', e);
+    }
+};
+
+export const flushTelemetry = () => {
+    let hasData = summary.enqueued !== 0 || summary.batches !== 0 || summary.failed !== 0;
+
+    if (hasData) {
+        logEvent('Sync Summary', Object.assign({
+            'window seconds': Math.round((Date.now() - windowStart) / 1000)
+        }, summary));
+
+        Object.keys(latency).forEach((resource) => {
+            logEvent('Sync Latency', Object.assign({resource: resource}, latency[resource]));
+        });
+    }
+    resetWindow();
+};
+
+const checkWindow = () => {
+    if (Date.now() - windowStart >= Constant.syncTelemetryWindow) {
+        flushTelemetry();
+    }
+};
+
+const recordDepth = (depth) => {
+    summary.lastDepth = depth;
+    summary.maxDepth = Math.max(summary.maxDepth, depth);
+};
+
+export const recordEnqueue = (depth) => {
+    checkWindow();
+    summary.enqueued++;
+    recordDepth(depth);
+};
+
+//One answered batch: the operations the server acknowledged, the request size on the wire and
+//the round trip they shared
+export const recordBatch = (operations, bytes, ms) => {
+    checkWindow();
+    summary.batches++;
+    summary.acked += operations.length;
+    summary.bytes += bytes;
+
+    operations.forEach((operation) => {
+        let histogram = latency[operation.resource];
+        if (histogram === undefined) {
+            histogram = latency[operation.resource] = {count: 0, 'total ms': 0};
+        }
+        let bucket = getBucketName(ms);
+        histogram.count++;
+        histogram['total ms'] += ms;
+        histogram[bucket] = (histogram[bucket] || 0) + 1;
+    });
+
+    if (drain !== null) {
+        drain.operations += operations.length;
+        drain.bytes += bytes;
+    }
+};
+
+//`errorClass` is one of services/retryPolicy, failures are also counted per class
+export const recordFailure = (operations, errorClass) => {
+    checkWindow();
+    summary.failed += operations.length;
+    if (errorClass) {
+        let key = 'failed ' + errorClass;
+        summary[key] = (summary[key] || 0) + operations.length;
+    }
+};
+
+export const recordRetry = () => {
+    summary.retries++;
+};
+
+//Connectivity came back, time-to-drain is measured from here
+export const recordReconnect = () => {
+    if (drain === null) {
+        drain = {start: Date.now(), operations: 0, bytes: 0};
+    }
+};
+
+export const recordDrained = (depth) => {
+    recordDepth(depth);
+    if (drain !== null) {
+        if (drain.operations !== 0) {
+            logEvent('Sync Drain', {
+                'drain ms': Date.now() - drain.start,
+                operations: drain.operations,
+                bytes: drain.bytes
+            });
+        }
+        drain = null;
+    }
+};
@@ -0,0 +1,79 @@
+import sortBy from 'lodash/sortBy';
+
+//Lookup tables compiled once per template schema.
+//
+//Screens find sections, subsections and form elements of the selected template by id. The
+//schema is a nested list (sections -> subsections -> form.form_elements), so every lookup was a
+//scan. A compiled template keeps the schema it was built from and
+//  sections            section_id -> section
+//  sectionList         sections in `order`
+//  subsections         subsection_id -> subsection
+//  subsectionList      section_id -> subsections in `order`
+//  elements            subsection_id -> form elements in `order`
+//  elementsByGuid      element guid -> form element
+//  options             element guid -> options
+//  defaults            subsection_id -> {element guid: default value}, elements without one are left out
+
+const EMPTY_LIST = [];
+
+const byOrder = (list) => sortBy(list || EMPTY_LIST, (item) => item.order);
+
+export const compileTemplate = (template) => {
+    let compiled = {
+        source: template,
+        sections: {},
+        sectionList: byOrder(template.sections),
+        subsections: {},
+        subsectionList: {},
+        elements: {},
+        elementsByGuid: {},
+        options: {},
+        defaults: {}
+    };
+
+    compiled.sectionList.forEach((section) => {
+        let subsections = byOrder(section.subsections);
+        compiled.sections[section.section_id] = section;
+        compiled.subsectionList[section.section_id] = subsections;
+
+        subsections.forEach((subsection) => {
+            let elements = byOrder(subsection.form && subsection.form.form_elements);
+            let defaults = {};
+            elements.forEach((element) => {
+                compiled.elementsByGuid[element.guid] = element;
+                compiled.options[element.guid] = element.options || EMPTY_LIST;
+                if (element.default_value !== undefined && element.default_value !== null) {
+                    defaults[element.guid] = element.default_value;
+                }
+            });
+            compiled.subsections[subsection.subsection_id] = subsection;
+            compiled.elements[subsection.subsection_id] = elements;
+            compiled.defaults[subsection.subsection_id] = defaults;
+        });
+    });
+    return compiled;
+};
+
+//Compiles the templates of a full list, templates identical to the ones `previous` was compiled
+//from are kept, so a new list compiles only the templates that changed
+export const compileTemplates = (previous, templates) => {
+    let next = {};
+    (templates || EMPTY_LIST).forEach((template, index) => {
+        let old = previous[template.template_id];
+        let compiled = (old !== undefined && old.source === template) ? old : compileTemplate(template);
+        next[template.template_id] = (compiled.position === index) ? compiled : Object.assign({}, compiled, {position: index});
+    });
+    return next;
+};
+
+export const getCompiledSection = (compiled, section_id) => {
+    return compiled ? compiled.sections[section_id] : undefined;
+};
+
+export const getCompiledSubsections = (compiled, section_id) => {
+    return (compiled && compiled.subsectionList[section_id]) || EMPTY_LIST;
+};
+
+export const getCompiledElements = (compiled, subsection_id) => {
+    return (compiled && compiled.elements[subsection_id]) || EMPTY_LIST;
+};